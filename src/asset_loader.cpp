@@ -0,0 +1,88 @@
+#include <asset_loader.hpp>
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include <profiler.hpp>
+
+namespace glint {
+
+AssetLoader::AssetLoader(size_t max_workers) noexcept : _max_workers(std::max(max_workers, size_t {1})) {}
+
+AssetLoader::~AssetLoader() noexcept {
+    for (auto& w : _workers) w.request_stop();
+    _wake.notify_all();
+    _workers.clear();
+}
+
+auto AssetLoader::default_worker_count() noexcept -> size_t {
+    const auto hardware = size_t {std::thread::hardware_concurrency()};
+    return std::clamp(hardware > 1 ? hardware - 1 : 1, size_t {1}, size_t {4});
+}
+
+auto AssetLoader::pump() noexcept -> size_t {
+    auto done = std::vector<std::unique_ptr<ITask>> {};
+    {
+        auto lock = std::lock_guard {_mutex};
+        std::swap(done, _done);
+    }
+
+    for (const auto& task : done) {
+        auto zone = profiler::Zone {"asset.finish"};
+        try {
+            task->finish();
+        } catch (std::exception& e) {
+            SPDLOG_ERROR("Unexpected C++ exception while finishing asset task: {}", e.what());
+        } catch (...) {
+            SPDLOG_ERROR("Unknown exception while finishing asset task");
+        }
+    }
+
+    return done.size();
+}
+
+auto AssetLoader::pending() noexcept -> size_t {
+    auto lock = std::lock_guard {_mutex};
+    return _queue.size() + _running + _done.size();
+}
+
+auto AssetLoader::enqueue(std::unique_ptr<ITask> task) -> void {
+    {
+        auto lock = std::lock_guard {_mutex};
+        _queue.push_back(std::move(task));
+        if (_workers.size() < _max_workers && _queue.size() > _workers.size() - _running) {
+            SPDLOG_DEBUG("Starting asset loader worker {}", _workers.size());
+            _workers.emplace_back([this](std::stop_token stop) { worker(std::move(stop)); });
+        }
+    }
+    _wake.notify_one();
+}
+
+auto AssetLoader::worker(std::stop_token stop) noexcept -> void {
+    profiler::name_thread("Asset loader");
+    auto lock = std::unique_lock {_mutex};
+    // Queued tasks are dropped on stop, their `finish` is destroyed together with loader on main thread
+    while (_wake.wait(lock, stop, [this] { return !_queue.empty(); }) && !stop.stop_requested()) {
+        auto task = std::move(_queue.front());
+        _queue.pop_front();
+        _running++;
+        lock.unlock();
+
+        try {
+            auto zone = profiler::Zone {"asset.work"};
+            task->run();
+        } catch (std::exception& e) {
+            SPDLOG_ERROR("Unexpected C++ exception in asset task: {}", e.what());
+        } catch (...) {
+            SPDLOG_ERROR("Unknown exception in asset task");
+        }
+
+        lock.lock();
+        _running--;
+        // Task is handed back to main thread, which is the only one allowed to destroy it
+        _done.push_back(std::move(task));
+    }
+}
+
+} // namespace glint
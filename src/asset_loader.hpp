@@ -0,0 +1,105 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <error.hpp>
+
+namespace glint {
+
+/// Runs file reads and decoding on worker threads. Each task has two parts: `work`, which runs on worker and must not
+/// touch GPU, audio device or JS, and `finish`, which gets its result on main thread during `pump`.
+/// `finish` is only ever called and destroyed on main thread, so it may hold JS values. Work returns `Result`, and
+/// exception thrown by it is passed to `finish` as error, so that every finished task gets its result.
+class AssetLoader {
+  private:
+    struct ITask {
+        virtual auto run() -> void = 0;
+        virtual auto finish() -> void = 0;
+
+        virtual ~ITask() = default;
+        ITask() = default;
+        ITask(const ITask&) = delete;
+        ITask(ITask&&) = delete;
+        auto operator=(const ITask&) -> ITask& = delete;
+        auto operator=(ITask&&) -> ITask& = delete;
+    };
+
+    template<typename Work, typename Finish>
+    struct Task final: ITask {
+        using Output = std::invoke_result_t<Work&>;
+
+        Work work;
+        Finish on_finish;
+        std::optional<Output> output {};
+
+        Task(Work&& w, Finish&& f) : work(std::move(w)), on_finish(std::move(f)) {}
+
+        auto run() -> void override {
+            try {
+                output.emplace(work());
+            } catch (std::exception& e) {
+                output.emplace(err(e));
+            } catch (...) {
+                output.emplace(err("Unknown exception in asset task"));
+            }
+        }
+
+        auto finish() -> void override {
+            if (!output) output.emplace(err("Asset task did not complete"));
+            on_finish(std::move(*output));
+        }
+    };
+
+    size_t _max_workers;
+    std::mutex _mutex {};
+    std::condition_variable_any _wake {};
+    std::deque<std::unique_ptr<ITask>> _queue {};
+    std::vector<std::unique_ptr<ITask>> _done {};
+    size_t _running = 0;
+    // Declared last, so that workers are joined before queues are destroyed
+    std::vector<std::jthread> _workers {};
+
+  public:
+    /// Workers are started lazily on first task, games that never load asynchronously pay nothing
+    explicit AssetLoader(size_t max_workers = default_worker_count()) noexcept;
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader(AssetLoader&&) = delete;
+    auto operator=(const AssetLoader&) -> AssetLoader& = delete;
+    auto operator=(AssetLoader&&) -> AssetLoader& = delete;
+    ~AssetLoader() noexcept;
+
+    /// One worker less than hardware threads, leaving a core to main thread, but at most 4
+    [[nodiscard]]
+    static auto default_worker_count() noexcept -> size_t;
+
+    /// Queue `work` for worker thread and `finish(work())` for main thread
+    template<typename Work, typename Finish>
+        requires std::is_invocable_v<Finish&, std::invoke_result_t<Work&>&&>
+                 && std::is_constructible_v<std::invoke_result_t<Work&>, Unexpected<Error>>
+    auto submit(Work&& work, Finish&& finish) -> void {
+        using T = Task<std::decay_t<Work>, std::decay_t<Finish>>;
+        enqueue(std::make_unique<T>(std::forward<Work>(work), std::forward<Finish>(finish)));
+    }
+
+    /// Call `finish` of completed tasks on calling thread. Returns number of tasks finished
+    auto pump() noexcept -> size_t;
+
+    /// Number of tasks that are queued, running or waiting for `pump`
+    [[nodiscard]]
+    auto pending() noexcept -> size_t;
+
+  private:
+    auto enqueue(std::unique_ptr<ITask> task) -> void;
+    auto worker(std::stop_token stop) noexcept -> void;
+};
+
+} // namespace glint
@@ -0,0 +1,208 @@
+#include <atlas.hpp>
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include <fmt/format.h>
+
+namespace glint {
+
+// Index layout, all integers little-endian:
+//   header:  "GLAT", u32 version, u32 page count, u32 region count, u32 size of names
+//   pages:   u16 width, u16 height
+//   regions: u32 name offset, u16 name size, u16 page, u16 x, u16 y, u16 width, u16 height
+//   names:   UTF-8 names of all regions, without separators
+static constexpr auto INDEX_MAGIC = std::array<unsigned char, 4> {'G', 'L', 'A', 'T'};
+static constexpr auto INDEX_VERSION = uint32_t {1};
+static constexpr auto HEADER_SIZE = size_t {20};
+static constexpr auto PAGE_SIZE = size_t {4};
+static constexpr auto REGION_SIZE = size_t {16};
+static constexpr auto MAX_U16 = int {std::numeric_limits<uint16_t>::max()};
+
+/// Copy RGBA image into page, both are tightly packed
+static auto blit(rl::Image& page, const rl::Image& image, const PackRect& rect) noexcept -> void {
+    constexpr auto PIXEL_SIZE = size_t {4};
+    const auto row = size_t(rect.width) * PIXEL_SIZE;
+    const auto dst = static_cast<unsigned char *>(page.data);
+    const auto src = static_cast<const unsigned char *>(image.data);
+    for (auto y = 0; y < rect.height; y++) {
+        const auto offset = (size_t(rect.y + y) * size_t(page.width) + size_t(rect.x)) * PIXEL_SIZE;
+        std::memcpy(dst + offset, src + size_t(y) * row, row);
+    }
+}
+
+auto compose_atlas(std::vector<std::string> names, std::span<rl::Image> images, int page_size, int padding) noexcept
+    -> Result<ComposedAtlas> try {
+    if (names.size() != images.size()) return err("Every atlas image must have a name");
+
+    auto sizes = std::vector<PackSize> {};
+    sizes.reserve(images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        auto& image = images[i];
+        image.convert(PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+            return err(fmt::format("Atlas image {} can not be converted to RGBA", names[i]));
+        }
+        sizes.push_back({.width = image.width, .height = image.height});
+    }
+
+    auto layout = pack_atlas(sizes, page_size, padding);
+    if (!layout) return err(layout);
+
+    auto atlas = ComposedAtlas {
+        .index = {
+            .pages = std::move(layout->pages),
+            .names = std::move(names),
+            .placements = std::move(layout->placements),
+        },
+    };
+    for (const auto& size : atlas.index.pages) {
+        atlas.pages.push_back(rl::Image::gen_color(size.width, size.height, BLANK));
+        if (atlas.pages.back().data == nullptr) return err("Could not allocate atlas page");
+    }
+    for (size_t i = 0; i < images.size(); i++) {
+        const auto& placement = atlas.index.placements[i];
+        blit(atlas.pages[placement.page], images[i], placement.rect);
+    }
+    return atlas;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+static auto put_u16(std::vector<unsigned char>& out, uint32_t value) -> void {
+    out.push_back(static_cast<unsigned char>(value & 0xff));
+    out.push_back(static_cast<unsigned char>((value >> 8) & 0xff));
+}
+
+static auto put_u32(std::vector<unsigned char>& out, uint32_t value) -> void {
+    put_u16(out, value & 0xffff);
+    put_u16(out, value >> 16);
+}
+
+static auto get_u16(std::span<const unsigned char> bytes, size_t offset) noexcept -> uint32_t {
+    return uint32_t(bytes[offset]) | uint32_t(bytes[offset + 1]) << 8;
+}
+
+static auto get_u32(std::span<const unsigned char> bytes, size_t offset) noexcept -> uint32_t {
+    return get_u16(bytes, offset) | get_u16(bytes, offset + 2) << 16;
+}
+
+auto encode_atlas_index(const AtlasIndex& index) noexcept -> Result<std::vector<unsigned char>> try {
+    if (index.names.size() != index.placements.size()) return err("Every atlas region must have a name");
+
+    auto names_size = size_t {};
+    for (const auto& name : index.names) {
+        if (name.size() > size_t(MAX_U16)) return err(fmt::format("Atlas region name {} is too long", name));
+        names_size += name.size();
+    }
+    for (const auto& page : index.pages) {
+        if (page.width > MAX_U16 || page.height > MAX_U16) return err("Atlas page is too large for index");
+    }
+    if (names_size > std::numeric_limits<uint32_t>::max()) return err("Atlas region names are too long");
+
+    auto out = std::vector<unsigned char> {};
+    out.reserve(HEADER_SIZE + index.pages.size() * PAGE_SIZE + index.placements.size() * REGION_SIZE + names_size);
+    out.insert(out.end(), INDEX_MAGIC.begin(), INDEX_MAGIC.end());
+    put_u32(out, INDEX_VERSION);
+    put_u32(out, uint32_t(index.pages.size()));
+    put_u32(out, uint32_t(index.placements.size()));
+    put_u32(out, uint32_t(names_size));
+
+    for (const auto& page : index.pages) {
+        put_u16(out, uint32_t(page.width));
+        put_u16(out, uint32_t(page.height));
+    }
+
+    auto name_offset = uint32_t {};
+    for (size_t i = 0; i < index.placements.size(); i++) {
+        const auto& [page, rect] = index.placements[i];
+        put_u32(out, name_offset);
+        put_u16(out, uint32_t(index.names[i].size()));
+        put_u16(out, uint32_t(page));
+        put_u16(out, uint32_t(rect.x));
+        put_u16(out, uint32_t(rect.y));
+        put_u16(out, uint32_t(rect.width));
+        put_u16(out, uint32_t(rect.height));
+        name_offset += uint32_t(index.names[i].size());
+    }
+
+    for (const auto& name : index.names) out.insert(out.end(), name.begin(), name.end());
+    return out;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto decode_atlas_index(std::span<const unsigned char> bytes) noexcept -> Result<AtlasIndex> try {
+    if (bytes.size() < HEADER_SIZE || !std::equal(INDEX_MAGIC.begin(), INDEX_MAGIC.end(), bytes.begin())) {
+        return err("Not an atlas index");
+    }
+    if (const auto version = get_u32(bytes, 4); version != INDEX_VERSION) {
+        return err(fmt::format("Unsupported atlas index version {}", version));
+    }
+
+    const auto page_count = size_t {get_u32(bytes, 8)};
+    const auto region_count = size_t {get_u32(bytes, 12)};
+    const auto names_size = size_t {get_u32(bytes, 16)};
+    const auto pages_offset = HEADER_SIZE;
+    const auto regions_offset = pages_offset + page_count * PAGE_SIZE;
+    const auto names_offset = regions_offset + region_count * REGION_SIZE;
+    if (bytes.size() != names_offset + names_size) return err("Atlas index is truncated or corrupted");
+
+    auto index = AtlasIndex {};
+    index.pages.reserve(page_count);
+    index.names.reserve(region_count);
+    index.placements.reserve(region_count);
+
+    for (size_t i = 0; i < page_count; i++) {
+        const auto offset = pages_offset + i * PAGE_SIZE;
+        index.pages.push_back({.width = int(get_u16(bytes, offset)), .height = int(get_u16(bytes, offset + 2))});
+    }
+
+    const auto names = bytes.subspan(names_offset);
+    for (size_t i = 0; i < region_count; i++) {
+        const auto offset = regions_offset + i * REGION_SIZE;
+        const auto name_offset = size_t {get_u32(bytes, offset)};
+        const auto name_size = size_t {get_u16(bytes, offset + 4)};
+        const auto placement = AtlasPlacement {
+            .page = get_u16(bytes, offset + 6),
+            .rect = {
+                .x = int(get_u16(bytes, offset + 8)),
+                .y = int(get_u16(bytes, offset + 10)),
+                .width = int(get_u16(bytes, offset + 12)),
+                .height = int(get_u16(bytes, offset + 14)),
+            },
+        };
+
+        if (name_offset + name_size > names.size() || placement.page >= page_count) {
+            return err("Atlas index is corrupted");
+        }
+        const auto& page = index.pages[placement.page];
+        const auto& rect = placement.rect;
+        if (rect.x + rect.width > page.width || rect.y + rect.height > page.height) {
+            return err("Atlas index region is outside of its page");
+        }
+
+        const auto name = names.subspan(name_offset, name_size);
+        index.names.emplace_back(name.begin(), name.end());
+        index.placements.push_back(placement);
+    }
+    return index;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Folder path without trailing separator, so that suffix goes to folder name
+static auto folder(const std::filesystem::path& dir) -> std::filesystem::path {
+    return dir.has_filename() ? dir : dir.parent_path();
+}
+
+auto atlas_index_path(const std::filesystem::path& dir) -> std::filesystem::path {
+    return folder(dir).concat(".bin");
+}
+
+auto atlas_page_path(const std::filesystem::path& dir, size_t page) -> std::filesystem::path {
+    return folder(dir).concat(fmt::format(".{}.png", page));
+}
+
+} // namespace glint
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <atlas_packer.hpp>
+#include <error.hpp>
+#include <raylib.hpp>
+
+namespace glint {
+
+constexpr auto DEFAULT_ATLAS_PAGE_SIZE = 2048;
+constexpr auto DEFAULT_ATLAS_PADDING = 2;
+
+/// Extension of sprite folders that are baked into atlases by `glint pack` and `glint bake`
+constexpr auto ATLAS_FOLDER_EXTENSION = ".atlas";
+
+/// Regions of atlas pages, without page pixels
+struct AtlasIndex {
+    std::vector<PackSize> pages {};
+    std::vector<std::string> names {};
+    /// Placement of every named region, in same order as `names`
+    std::vector<AtlasPlacement> placements {};
+};
+
+struct ComposedAtlas {
+    AtlasIndex index {};
+    std::vector<rl::Image> pages {};
+};
+
+/// Pack images and copy them into RGBA page images. Does not touch GPU, so it can run on worker thread.
+/// Images are converted to RGBA in place
+[[nodiscard]]
+auto compose_atlas(std::vector<std::string> names, std::span<rl::Image> images, int page_size, int padding) noexcept
+    -> Result<ComposedAtlas>;
+
+/// Serialize index into compact little-endian binary form, that is read back without any parsing of text
+[[nodiscard]]
+auto encode_atlas_index(const AtlasIndex& index) noexcept -> Result<std::vector<unsigned char>>;
+
+[[nodiscard]]
+auto decode_atlas_index(std::span<const unsigned char> bytes) noexcept -> Result<AtlasIndex>;
+
+/// Index baked from sprite folder `dir`, placed next to it as `<dir>.bin`
+[[nodiscard]]
+auto atlas_index_path(const std::filesystem::path& dir) -> std::filesystem::path;
+
+/// Page image baked from sprite folder `dir`, placed next to it as `<dir>.<page>.png`
+[[nodiscard]]
+auto atlas_page_path(const std::filesystem::path& dir, size_t page) -> std::filesystem::path;
+
+} // namespace glint
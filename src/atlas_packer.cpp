@@ -0,0 +1,148 @@
+#include <atlas_packer.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <fmt/format.h>
+
+namespace glint {
+
+static auto intersects(const PackRect& a, const PackRect& b) noexcept -> bool {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static auto contains(const PackRect& outer, const PackRect& inner) noexcept -> bool {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width
+           && inner.y + inner.height <= outer.y + outer.height;
+}
+
+MaxRectsPacker::MaxRectsPacker(int width, int height) :
+    _width(width),
+    _height(height),
+    _free {PackRect {.x = 0, .y = 0, .width = width, .height = height}} {}
+
+auto MaxRectsPacker::insert(int width, int height) -> std::optional<PackRect> {
+    if (width <= 0 || height <= 0 || width > _width || height > _height) return std::nullopt;
+
+    auto best = std::optional<PackRect> {};
+    auto best_short = std::numeric_limits<int>::max();
+    auto best_long = std::numeric_limits<int>::max();
+    for (const auto& free : _free) {
+        if (free.width < width || free.height < height) continue;
+        const auto dw = free.width - width;
+        const auto dh = free.height - height;
+        const auto short_side = std::min(dw, dh);
+        const auto long_side = std::max(dw, dh);
+        if (short_side < best_short || (short_side == best_short && long_side < best_long)) {
+            best = PackRect {.x = free.x, .y = free.y, .width = width, .height = height};
+            best_short = short_side;
+            best_long = long_side;
+        }
+    }
+    if (!best) return std::nullopt;
+
+    split(*best);
+    prune();
+    _used.width = std::max(_used.width, best->x + best->width);
+    _used.height = std::max(_used.height, best->y + best->height);
+    return best;
+}
+
+auto MaxRectsPacker::used() const noexcept -> PackSize {
+    return _used;
+}
+
+/// Replace every free rectangle overlapping `used` with up to four maximal rectangles around it
+auto MaxRectsPacker::split(const PackRect& used) -> void {
+    auto next = std::vector<PackRect> {};
+    next.reserve(_free.size() + 4);
+    const auto right = used.x + used.width;
+    const auto bottom = used.y + used.height;
+    for (const auto& free : _free) {
+        if (!intersects(free, used)) {
+            next.push_back(free);
+            continue;
+        }
+        const auto free_right = free.x + free.width;
+        const auto free_bottom = free.y + free.height;
+        if (used.x > free.x) {
+            next.push_back({.x = free.x, .y = free.y, .width = used.x - free.x, .height = free.height});
+        }
+        if (right < free_right) {
+            next.push_back({.x = right, .y = free.y, .width = free_right - right, .height = free.height});
+        }
+        if (used.y > free.y) {
+            next.push_back({.x = free.x, .y = free.y, .width = free.width, .height = used.y - free.y});
+        }
+        if (bottom < free_bottom) {
+            next.push_back({.x = free.x, .y = bottom, .width = free.width, .height = free_bottom - bottom});
+        }
+    }
+    _free = std::move(next);
+}
+
+/// Drop free rectangles contained in other ones, they can never give a better fit
+auto MaxRectsPacker::prune() -> void {
+    auto removed = std::vector<bool>(_free.size(), false);
+    for (size_t i = 0; i < _free.size(); i++) {
+        if (removed[i]) continue;
+        for (size_t j = i + 1; j < _free.size(); j++) {
+            if (removed[j]) continue;
+            if (contains(_free[j], _free[i])) {
+                removed[i] = true;
+                break;
+            }
+            if (contains(_free[i], _free[j])) removed[j] = true;
+        }
+    }
+    auto i = size_t {};
+    std::erase_if(_free, [&](const PackRect&) { return removed[i++]; });
+}
+
+auto pack_atlas(std::span<const PackSize> sizes, int page_size, int padding) noexcept -> Result<AtlasLayout> try {
+    if (page_size <= 0) return err("Atlas page size must be positive");
+    if (padding < 0) return err("Atlas padding must not be negative");
+
+    auto order = std::vector<size_t>(sizes.size());
+    std::iota(order.begin(), order.end(), size_t {});
+    std::ranges::stable_sort(order, std::greater<> {}, [&](size_t i) {
+        return std::pair {std::max(sizes[i].width, sizes[i].height), std::min(sizes[i].width, sizes[i].height)};
+    });
+
+    // Padding goes after each rectangle, growing page by it lets the last ones touch page edge
+    auto pages = std::vector<MaxRectsPacker> {};
+    auto layout = AtlasLayout {.placements = std::vector<AtlasPlacement>(sizes.size())};
+    for (const auto i : order) {
+        const auto [width, height] = sizes[i];
+        if (width <= 0 || height <= 0) return err(fmt::format("Atlas image {} has empty size {}x{}", i, width, height));
+        if (width > page_size || height > page_size) {
+            return err(fmt::format("Atlas image {} of {}x{} is larger than page of {}", i, width, height, page_size));
+        }
+
+        auto placed = std::optional<AtlasPlacement> {};
+        for (size_t page = 0; page < pages.size() && !placed; page++) {
+            const auto rect = pages[page].insert(width + padding, height + padding);
+            if (rect) placed = AtlasPlacement {page, *rect};
+        }
+        if (!placed) {
+            // Rectangle was checked to fit into empty page
+            pages.emplace_back(page_size + padding, page_size + padding);
+            placed = AtlasPlacement {pages.size() - 1, *pages.back().insert(width + padding, height + padding)};
+        }
+
+        placed->rect.width = width;
+        placed->rect.height = height;
+        layout.placements[i] = *placed;
+    }
+
+    for (const auto& packer : pages) {
+        const auto used = packer.used();
+        layout.pages.push_back({.width = used.width - padding, .height = used.height - padding});
+    }
+    return layout;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace glint
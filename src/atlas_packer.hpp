@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <error.hpp>
+
+namespace glint {
+
+struct PackSize {
+    int width = 0;
+    int height = 0;
+};
+
+struct PackRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+/// Rectangle packer for one atlas page using MaxRects with best short side fit.
+/// Free space is kept as list of maximal, possibly overlapping, free rectangles, so a rectangle can go into any gap
+/// left by earlier ones, not only on top of a skyline.
+class MaxRectsPacker {
+  private:
+    int _width;
+    int _height;
+    std::vector<PackRect> _free {};
+    PackSize _used {};
+
+  public:
+    MaxRectsPacker(int width, int height);
+
+    /// Place rectangle of given size, or return nothing if it does not fit anywhere
+    [[nodiscard]]
+    auto insert(int width, int height) -> std::optional<PackRect>;
+
+    /// Bounding size of placed rectangles
+    [[nodiscard]]
+    auto used() const noexcept -> PackSize;
+
+  private:
+    auto split(const PackRect& used) -> void;
+    auto prune() -> void;
+};
+
+struct AtlasPlacement {
+    size_t page = 0;
+    PackRect rect {};
+};
+
+struct AtlasLayout {
+    /// Placement of every input size, in input order
+    std::vector<AtlasPlacement> placements {};
+    /// Pages are cropped to what their rectangles use
+    std::vector<PackSize> pages {};
+};
+
+/// Pack rectangles into as few pages of at most `page_size` square as possible, keeping `padding` pixels between them.
+/// Larger rectangles are placed first, and each one goes to the first page it fits into
+[[nodiscard]]
+auto pack_atlas(std::span<const PackSize> sizes, int page_size, int padding) noexcept -> Result<AtlasLayout>;
+
+} // namespace glint
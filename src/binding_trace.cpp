@@ -0,0 +1,21 @@
+#include <binding_trace.hpp>
+
+#include <memory>
+
+namespace glint::binding_trace {
+
+static auto bindings_logger = std::shared_ptr<spdlog::logger> {};
+
+auto enable() -> void {
+    // Shares sinks with default logger, but is not limited by its level
+    bindings_logger = spdlog::default_logger()->clone("bindings");
+    bindings_logger->set_level(spdlog::level::trace);
+    active = true;
+    SPDLOG_INFO("Tracing calls of native bindings");
+}
+
+auto logger() noexcept -> spdlog::logger& {
+    return *bindings_logger;
+}
+
+} // namespace glint::binding_trace
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+/// Log of every call from JS into native bindings, enabled with `--trace-bindings`. Unlike SPDLOG_TRACE it is kept in
+/// release builds, but while disabled it costs one branch and its arguments are not even evaluated
+namespace glint::binding_trace {
+
+/// Only written by `enable`, before game is loaded
+inline constinit auto active = false;
+
+/// Start logging binding calls through `bindings` logger
+auto enable() -> void;
+
+/// Logger of binding calls, only valid after `enable`
+[[nodiscard]]
+auto logger() noexcept -> spdlog::logger&;
+
+} // namespace glint::binding_trace
+
+#define GLINT_TRACE_BINDING(...) /* NOLINT */                                                                         \
+    do {                                                                                                               \
+        if (::glint::binding_trace::active) [[unlikely]] {                                                             \
+            ::glint::binding_trace::logger().log(                                                                      \
+                spdlog::source_loc {__FILE__, __LINE__, SPDLOG_FUNCTION}, spdlog::level::trace, __VA_ARGS__           \
+            );                                                                                                         \
+        }                                                                                                              \
+    } while (false)
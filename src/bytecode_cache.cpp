@@ -0,0 +1,260 @@
+#include <bytecode_cache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <random>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <defer.hpp>
+#include <file_store.hpp>
+
+namespace glint {
+
+static constexpr auto MAGIC = std::array<char, 8> {'G', 'L', 'I', 'N', 'T', 'J', 'S', '2'};
+
+/// Cache file layout: header, source module was compiled from, bytecode.
+/// Key only names the entry, source is compared in full, so that colliding keys never run wrong bytecode
+struct BytecodeHeader {
+    std::array<char, 8> magic;
+    uint64_t key;
+    uint64_t source_size;
+};
+
+/// FNV-1a over all parts, stable between runs and platforms unlike std::hash
+static auto hash_key(std::initializer_list<std::string_view> parts) noexcept -> uint64_t {
+    constexpr auto PRIME = uint64_t {0x100000001b3};
+    auto state = uint64_t {0xcbf29ce484222325};
+    for (const auto part : parts) {
+        for (const auto c : part) {
+            state ^= static_cast<unsigned char>(c);
+            state *= PRIME;
+        }
+        // Separator, so that ("ab", "c") and ("a", "bc") differ
+        state ^= 0xffu;
+        state *= PRIME;
+    }
+    return state;
+}
+
+/// Cached bytecode is executed as is, so directory must not be writable by other users. On POSIX it has to be owned
+/// by current user and private to them, directory with group or other access that user owns is made private
+static auto check_private(const std::filesystem::path& dir) -> Result<> {
+#ifdef _WIN32
+    // Local app data directory is per-user already
+    (void)dir;
+    return {};
+#else
+    struct stat st {};
+    if (::lstat(dir.c_str(), &st) < 0) return err(fmt::format("Could not stat {}: {}", dir.string(), strerror(errno)));
+    if (!S_ISDIR(st.st_mode)) return err(fmt::format("{} is not a directory", dir.string()));
+    if (st.st_uid != ::geteuid()) return err(fmt::format("{} is owned by another user", dir.string()));
+    if ((st.st_mode & 077) != 0 && ::chmod(dir.c_str(), 0700) < 0) {
+        return err(fmt::format("Could not make {} private: {}", dir.string(), strerror(errno)));
+    }
+    return {};
+#endif
+}
+
+/// Remove entries not used for `MAX_ENTRY_AGE` and temporary files left by runs that crashed while writing
+static auto prune(const std::filesystem::path& dir) noexcept -> void try {
+    using Duration = std::filesystem::file_time_type::duration;
+    const auto now = std::filesystem::file_time_type::clock::now();
+    auto ec = std::error_code {};
+    auto removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        const auto ext = entry.path().extension();
+        if (ext != ".jsbc" && ext != ".tmp") continue;
+        const auto max_age = ext == ".tmp" ? Duration {std::chrono::days {1}} : Duration {MAX_ENTRY_AGE};
+        const auto written = entry.last_write_time(ec);
+        if (ec || now - written < max_age) continue;
+        if (std::filesystem::remove(entry.path(), ec)) removed++;
+    }
+    if (removed > 0) SPDLOG_DEBUG("Removed {} stale bytecode cache entries", removed);
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not prune bytecode cache: {}", e.what());
+}
+
+auto BytecodeCache::open(const std::filesystem::path& dir, const std::filesystem::path& game_path) noexcept
+    -> BytecodeCache try {
+    auto ec = std::error_code {};
+    if (!std::filesystem::exists(dir, ec)) {
+        std::filesystem::create_directories(dir.parent_path(), ec);
+#ifdef _WIN32
+        std::filesystem::create_directory(dir, ec);
+#else
+        if (::mkdir(dir.c_str(), 0700) < 0 && errno != EEXIST) ec = std::error_code {errno, std::generic_category()};
+#endif
+    }
+    if (ec) {
+        SPDLOG_WARN("Bytecode cache disabled, could not create {}: {}", dir.string(), ec.message());
+        return disabled();
+    }
+    if (auto r = check_private(dir); !r) {
+        SPDLOG_WARN("Bytecode cache disabled: {}", r.error()->msg());
+        return disabled();
+    }
+    prune(dir);
+    SPDLOG_DEBUG("Using bytecode cache at {}", dir.string());
+    // Games share cache directory and module names like `game.js`, so entries are told apart by game location
+    return BytecodeCache {dir, std::filesystem::weakly_canonical(std::filesystem::absolute(game_path)).string()};
+} catch (std::exception& e) {
+    SPDLOG_WARN("Bytecode cache disabled: {}", e.what());
+    return disabled();
+}
+
+auto BytecodeCache::disabled() noexcept -> BytecodeCache {
+    return BytecodeCache {std::nullopt, {}};
+}
+
+auto BytecodeCache::default_dir() noexcept -> std::optional<std::filesystem::path> try {
+    // NOLINTBEGIN: environment is not modified concurrently
+    if (const auto env = std::getenv("GLINT_CACHE_DIR"); env != nullptr && *env != '\0') {
+        return std::filesystem::path {env};
+    }
+
+#ifdef _WIN32
+    if (const auto env = std::getenv("LOCALAPPDATA"); env != nullptr && *env != '\0') {
+        return std::filesystem::path {env} / "glint" / "bytecode";
+    }
+#else
+    if (const auto env = std::getenv("XDG_CACHE_HOME"); env != nullptr && *env == '/') {
+        return std::filesystem::path {env} / "glint" / "bytecode";
+    }
+    if (const auto env = std::getenv("HOME"); env != nullptr && *env == '/') {
+        return std::filesystem::path {env} / ".cache" / "glint" / "bytecode";
+    }
+#endif
+    // NOLINTEND
+    return std::nullopt;
+} catch (...) {
+    return std::nullopt;
+}
+
+auto BytecodeCache::compile_module(not_null<JSContext *> js, std::string_view source, const std::string& name, int flags)
+    const noexcept -> JSValue try {
+    const auto compile = [&]() {
+        return JS_Eval(
+            js,
+            source.data(),
+            source.size(),
+            name.c_str(),
+            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY | flags
+        );
+    };
+
+    if (!_dir) return compile();
+
+    const auto flags_str = fmt::format("{}", flags);
+    const auto key = hash_key({JS_GetVersion(), _game, name, flags_str});
+    const auto path = entry_path(key);
+
+    if (auto ec = std::error_code {}; std::filesystem::is_regular_file(path, ec)) {
+        const auto data = MappedBuffer::map_file(path);
+        auto header = BytecodeHeader {};
+        if (data && data->size() > sizeof(header)) std::memcpy(&header, data->bytes().data(), sizeof(header));
+        const auto body = data ? data->bytes().subspan(std::min(data->size(), sizeof(header)))
+                               : std::span<const unsigned char> {};
+
+        if (header.magic == MAGIC && header.key == key && header.source_size == source.size()
+            && body.size() > source.size() && std::memcmp(body.data(), source.data(), source.size()) == 0) {
+            auto compiled = deserialize(js, body.subspan(source.size()));
+            if (!JS_IsException(compiled)) {
+                SPDLOG_DEBUG("Module {} loaded from bytecode cache", name);
+                // Entries of games that are still played are never pruned
+                std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+                return compiled;
+            }
+            // Imports that fail to resolve fail same way when compiling, and then error is reported from there
+            JS_FreeValue(js, JS_GetException(js));
+        }
+        SPDLOG_DEBUG("Bytecode cache entry {} is stale, recompiling {}", path.string(), name);
+    }
+
+    auto compiled = compile();
+    if (JS_IsException(compiled)) return compiled;
+
+    auto bytecode = serialize(js, compiled);
+    if (!bytecode) {
+        SPDLOG_WARN("Could not serialize module {}: {}", name, bytecode.error()->msg());
+        return compiled;
+    }
+
+    // Write to temporary file of unique name first, so that concurrent runs neither see partial entry nor write
+    // into same file
+    const auto suffix = uint64_t {std::random_device {}()} << 32 | std::random_device {}();
+    const auto tmp_path = std::filesystem::path {path}.concat(fmt::format(".{:016x}.tmp", suffix));
+    {
+        auto file = std::ofstream {tmp_path, std::ios::out | std::ios::binary | std::ios::trunc};
+        const auto header = BytecodeHeader {.magic = MAGIC, .key = key, .source_size = source.size()};
+        // NOLINTBEGIN: writing raw bytes
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(source.data(), std::streamsize(source.size()));
+        file.write(reinterpret_cast<const char *>(bytecode->data()), std::streamsize(bytecode->size()));
+        // NOLINTEND
+        if (!file) {
+            SPDLOG_WARN("Could not write bytecode cache entry {}", tmp_path.string());
+            return compiled;
+        }
+    }
+
+    auto ec = std::error_code {};
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        SPDLOG_WARN("Could not store bytecode cache entry {}: {}", path.string(), ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    } else {
+        SPDLOG_DEBUG("Module {} stored in bytecode cache", name);
+    }
+
+    return compiled;
+} catch (std::exception& e) {
+    return JS_ThrowInternalError(js, "Could not compile module %s: %s", name.c_str(), e.what());
+}
+
+auto BytecodeCache::serialize(not_null<JSContext *> js, JSValueConst compiled) noexcept
+    -> Result<std::vector<uint8_t>> try {
+    auto size = size_t {};
+    const auto buf = JS_WriteObject(js, &size, compiled, JS_WRITE_OBJ_BYTECODE);
+    if (buf == nullptr) {
+        JS_FreeValue(js, JS_GetException(js));
+        return err("JS_WriteObject failed");
+    }
+    defer(js_free(js, buf));
+    return std::vector<uint8_t>(buf, buf + size);
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto BytecodeCache::deserialize(not_null<JSContext *> js, std::span<const uint8_t> bytecode) noexcept -> JSValue {
+    auto compiled = JS_ReadObject(js, bytecode.data(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+    if (JS_IsException(compiled)) return compiled;
+
+    // Unlike module compiled by JS_Eval, module read from bytecode has its imports unresolved
+    if (JS_VALUE_GET_TAG(compiled) == JS_TAG_MODULE && JS_ResolveModule(js, compiled) < 0) {
+        JS_FreeValue(js, compiled);
+        return JS_EXCEPTION;
+    }
+    return compiled;
+}
+
+BytecodeCache::BytecodeCache(std::optional<std::filesystem::path> dir, std::string game) noexcept :
+    _dir(std::move(dir)),
+    _game(std::move(game)) {}
+
+auto BytecodeCache::entry_path(uint64_t key) const -> std::filesystem::path {
+    return *_dir / fmt::format("{:016x}.jsbc", key);
+}
+
+} // namespace glint
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gsl/gsl>
+#include <quickjs.h>
+
+#include <error.hpp>
+
+namespace glint {
+
+using namespace gsl;
+
+/// Cache entries not used for this long belong to moved or deleted games, they are removed when cache is opened
+constexpr auto MAX_ENTRY_AGE = std::chrono::days {30};
+
+/// On-disk cache of compiled JS modules.
+/// Every module of a game has one entry, named by game path, module name, compile flags and QuickJS version. Entry
+/// stores full source it was compiled from and is used only when source matches exactly, edited module overwrites
+/// its entry. Cache failures are never fatal: module is compiled from source instead.
+class BytecodeCache {
+  private:
+    std::optional<std::filesystem::path> _dir;
+    std::string _game {};
+
+  public:
+    /// Use `dir` as cache directory for modules of game at `game_path`, creating it private to current user if
+    /// needed. Cache is disabled if directory is not usable or other users could write to it. Entries that were not
+    /// used for `MAX_ENTRY_AGE` are removed
+    static auto open(const std::filesystem::path& dir, const std::filesystem::path& game_path) noexcept
+        -> BytecodeCache;
+
+    /// Cache that always compiles from source
+    static auto disabled() noexcept -> BytecodeCache;
+
+    /// `$GLINT_CACHE_DIR` or `glint/bytecode` inside per-user cache directory: `$XDG_CACHE_HOME`, `~/.cache` or
+    /// `%LOCALAPPDATA%`
+    static auto default_dir() noexcept -> std::optional<std::filesystem::path>;
+
+    /// Compile module like `JS_Eval(..., JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY | flags)`, reusing cached
+    /// bytecode when source did not change. On failure returns exception and leaves it pending in context.
+    [[nodiscard]]
+    auto compile_module(not_null<JSContext *> js, std::string_view source, const std::string& name, int flags = 0)
+        const noexcept -> JSValue;
+
+    /// Serialize compiled module or function to bytecode
+    [[nodiscard]]
+    static auto serialize(not_null<JSContext *> js, JSValueConst compiled) noexcept -> Result<std::vector<uint8_t>>;
+
+    /// Read compiled module or function from bytecode and resolve imports of module.
+    /// On failure returns exception and leaves it pending in context
+    [[nodiscard]]
+    static auto deserialize(not_null<JSContext *> js, std::span<const uint8_t> bytecode) noexcept -> JSValue;
+
+  private:
+    BytecodeCache(std::optional<std::filesystem::path> dir, std::string game) noexcept;
+
+    [[nodiscard]]
+    auto entry_path(uint64_t key) const -> std::filesystem::path;
+};
+
+} // namespace glint
@@ -1,14 +1,34 @@
 #pragma once
 
+#include <algorithm>
+#include <cctype>
 #include <string>
 #include <span>
 #include <filesystem>
+#include <memory>
 
+#include <fmt/format.h>
+
+#include <glyph_cache.hpp>
 #include <raylib.hpp>
 #include <resource_store.hpp>
+#include <texture_container.hpp>
 
 namespace glint {
 
+/// GPU memory used by texture with all its mipmap levels
+inline auto texture_size_bytes(const ::Texture& texture) noexcept -> size_t {
+    auto bytes = size_t {};
+    auto width = texture.width;
+    auto height = texture.height;
+    for (auto level = 0; level < std::max(texture.mipmaps, 1); level++) {
+        bytes += size_t(std::max(::GetPixelDataSize(width, height, texture.format), 0));
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+    }
+    return bytes;
+}
+
 struct TextureData {
     rl::Texture texture;
     std::filesystem::path name;
@@ -19,23 +39,79 @@ struct TextureData {
         return texture;
     }
 
+    [[nodiscard]]
+    auto size_bytes() const noexcept -> size_t {
+        return texture_size_bytes(texture);
+    }
+
     static auto load(const std::filesystem::path& name, IFileStore& file_store) noexcept -> TextureData try {
-        auto buf = file_store.read_bytes(name);
+        const auto path = texture_path(name, file_store);
+        const auto buf = file_store.map(path);
         if (!buf) {
             SPDLOG_WARN("Could not load texture {}: {}", name.string(), buf.error()->msg());
             return {};
         }
 
-        return load_from_memory(name, *buf);
+        return load_from_memory(path, buf->bytes());
+    } catch (...) {
+        return {};
+    }
+
+    /// Compressed copy of image stored by packer, if there is one, or image itself
+    static auto texture_path(const std::filesystem::path& name, IFileStore& file_store) -> std::filesystem::path {
+        auto compressed = compressed_texture_path(name);
+        return file_store.exists(compressed) ? compressed : name;
+    }
+
+    /// Decode texture file without touching GPU, so that it can run on worker thread. Compressed copy is preferred,
+    /// so result may be in GPU compressed format
+    static auto decode(const std::filesystem::path& name, IFileStore& file_store) noexcept -> Result<rl::Image> try {
+        return decode_image(texture_path(name, file_store), file_store);
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    /// Decode image file as it is, for uses that need its pixels
+    static auto decode_image(const std::filesystem::path& name, IFileStore& file_store) noexcept
+        -> Result<rl::Image> try {
+        const auto buf = file_store.map(name);
+        if (!buf) return err(buf);
+        return decode_memory(name, buf->bytes());
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    /// DDS and KTX containers are recognized by contents and keep their GPU format, whatever their extension.
+    /// Other formats are decoded to pixels by extension
+    static auto decode_memory(const std::filesystem::path& name, std::span<const unsigned char> buf) noexcept
+        -> Result<rl::Image> try {
+        if (is_texture_container(buf)) {
+            auto image = load_texture_container(buf);
+            if (!image) return err(fmt::format("Could not load texture {}: {}", name.string(), image.error()->msg()));
+            return image;
+        }
+        auto image = rl::Image::load_from_memory(name.extension().string().c_str(), buf);
+        if (!::IsImageValid(image)) return err(fmt::format("Could not decode image {}", name.string()));
+        return image;
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    /// Upload image decoded by `decode`
+    static auto from_image(const std::filesystem::path& name, const rl::Image& image) noexcept -> TextureData try {
+        return {.texture = rl::Texture::load_from_image(image), .name = name};
     } catch (...) {
         return {};
     }
 
-    static auto load_from_memory(const std::filesystem::path& name, std::span<char> buf) noexcept -> TextureData try {
-        // NOLINTNEXTLINE: cast from unsigned char* to char* is safe
-        const auto data = std::span(reinterpret_cast<unsigned char *>(buf.data()), int(buf.size()));
-        auto texture = rl::Texture::load_from_memory(name.extension().string().c_str(), data);
-        return {.texture = std::move(texture), .name = name};
+    static auto load_from_memory(const std::filesystem::path& name, std::span<const unsigned char> buf) noexcept
+        -> TextureData try {
+        const auto image = decode_memory(name, buf);
+        if (!image) {
+            SPDLOG_WARN("{}", image.error()->msg());
+            return {};
+        }
+        return from_image(name, *image);
     } catch (...) {
         return {};
     }
@@ -44,11 +120,36 @@ struct TextureData {
 struct FontData {
     rl::Font font;
     std::filesystem::path name;
+    /// Set for fonts rasterizing glyphs on demand, then font of cache is used instead of `font`
+    std::unique_ptr<GlyphCache> cache {};
 
     using data_type = rl::Font;
 
+    /// Font prepared off main thread. TTF and OTF glyphs are rasterized into atlas waiting for upload, other formats
+    /// keep file data for raylib to load on main thread
+    struct Decoded {
+        rl::Font font {};
+        rl::Image atlas {};
+        MappedBuffer data {};
+    };
+
     auto get() noexcept -> rl::Font& {
-        return font;
+        return cache ? cache->font() : font;
+    }
+
+    /// Atlas texture and glyph images with metrics, which raylib keeps in CPU memory
+    [[nodiscard]]
+    auto size_bytes() const noexcept -> size_t {
+        if (cache) return cache->size_bytes();
+        auto bytes = texture_size_bytes(font.texture);
+        if (font.glyphs == nullptr) return bytes;
+        for (const auto& glyph : std::span(font.glyphs, size_t(std::max(font.glyphCount, 0)))) {
+            const auto& image = glyph.image;
+            bytes += sizeof(::GlyphInfo) + sizeof(::Rectangle);
+            if (image.data == nullptr) continue;
+            bytes += size_t(std::max(::GetPixelDataSize(image.width, image.height, image.format), 0));
+        }
+        return bytes;
     }
 
     static auto load(
@@ -57,30 +158,99 @@ struct FontData {
         std::optional<std::span<int>> codepoints,
         IFileStore& file_store
     ) noexcept -> FontData try {
-        auto buf = file_store.read_bytes(name);
+        const auto buf = file_store.map(name);
         if (!buf) {
             SPDLOG_WARN("Could not load font {}: {}", name.string(), buf.error()->msg());
             return {};
         }
 
-        return load_from_memory(name, *buf, font_size, codepoints);
+        return load_from_memory(name, buf->bytes(), font_size, codepoints);
+    } catch (...) {
+        return {};
+    }
+
+    /// Read font and rasterize glyphs where possible without touching GPU, so that it can run on worker thread
+    static auto decode(
+        const std::filesystem::path& name,
+        int font_size,
+        std::optional<std::span<int>> codepoints,
+        IFileStore& file_store
+    ) noexcept -> Result<Decoded> try {
+        auto buf = file_store.map(name);
+        if (!buf) return err(buf);
+
+        auto extension = name.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        if (extension != ".ttf" && extension != ".otf") return Decoded {.data = std::move(*buf)};
+
+        auto decoded = Decoded {};
+        decoded.font = rl::Font::rasterize(buf->bytes(), font_size, codepoints, decoded.atlas);
+        if (decoded.font.glyphs == nullptr) return err(fmt::format("Could not decode font {}", name.string()));
+        return decoded;
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    /// Finish font prepared by `decode` on main thread
+    static auto from_decoded(
+        const std::filesystem::path& name,
+        Decoded&& decoded,
+        int font_size,
+        std::optional<std::span<int>> codepoints
+    ) noexcept -> FontData try {
+        if (!decoded.data.empty()) return load_from_memory(name, decoded.data.bytes(), font_size, codepoints);
+        decoded.font.upload_atlas(decoded.atlas);
+        return {.font = std::move(decoded.font), .name = name};
     } catch (...) {
         return {};
     }
 
     static auto load_from_memory(
         const std::filesystem::path& name,
-        std::span<char> buf,
+        std::span<const unsigned char> buf,
         int font_size,
         std::optional<std::span<int>> codepoints
     ) noexcept -> FontData try {
-        // NOLINTNEXTLINE: cast from unsigned char* to char* is safe
-        auto data = std::span(reinterpret_cast<unsigned char *>(buf.data()), int(buf.size()));
-        auto font = rl::Font::load_from_memory(name.extension().string().c_str(), data, font_size, codepoints);
+        auto font = rl::Font::load_from_memory(name.extension().string().c_str(), buf, font_size, codepoints);
         return {.font = std::move(font), .name = name};
     } catch (...) {
         return {};
     }
+
+    /// Font with glyph cache, `codepoints` are rasterized right away
+    static auto load_dynamic(
+        const std::filesystem::path& name,
+        int font_size,
+        std::optional<std::span<int>> codepoints,
+        IFileStore& file_store
+    ) noexcept -> FontData try {
+        auto buf = file_store.map(name);
+        if (!buf) {
+            SPDLOG_WARN("Could not load font {}: {}", name.string(), buf.error()->msg());
+            return {};
+        }
+        return from_memory_dynamic(name, std::move(*buf), font_size, codepoints);
+    } catch (...) {
+        return {};
+    }
+
+    /// Font with glyph cache over font file mapped by `load_dynamic` or on worker thread
+    static auto from_memory_dynamic(
+        const std::filesystem::path& name,
+        MappedBuffer&& buf,
+        int font_size,
+        std::optional<std::span<int>> codepoints
+    ) noexcept -> FontData try {
+        auto cache = GlyphCache::create(std::move(buf), font_size);
+        if (!cache) {
+            SPDLOG_WARN("Could not load font {}: {}", name.string(), cache.error()->msg());
+            return {};
+        }
+        if (codepoints) (*cache)->require(*codepoints);
+        return {.font = {}, .name = name, .cache = std::move(*cache)};
+    } catch (...) {
+        return {};
+    }
 };
 
 } // namespace glint
@@ -1,10 +1,19 @@
 #include "engine.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <raylib.h>
 
 #include <defer.hpp>
+#include <engine/audio.hpp>
 #include <engine/window.hpp>
+#include <pack.hpp>
+#include <profiler.hpp>
 #include <utility>
 
 namespace glint {
@@ -12,6 +21,30 @@ namespace glint {
 extern "C" auto module_loader(JSContext *ctx, const char *module_name, void *opaque) noexcept -> JSModuleDef *;
 auto read_config(js::Object& ns) -> Result<GameConfig>;
 
+/// Compile game module from store, preferring bytecode precompiled by `glint pack` over source.
+/// JS errors are returned as exception value and left pending in context
+static auto compile_game_module(
+    not_null<JSContext *> js,
+    IFileStore& store,
+    const std::filesystem::path& path,
+    const std::string& name,
+    int flags
+) -> Result<JSValue> {
+    const auto precompiled = std::filesystem::path {path}.replace_extension(PRECOMPILED_MODULE_EXTENSION);
+    if (store.exists(precompiled)) {
+        SPDLOG_TRACE("Loading precompiled module {}", precompiled.string());
+        const auto bytecode = store.read_bytes(precompiled);
+        if (!bytecode) return err(bytecode);
+        // NOLINTNEXTLINE: bytecode is read as raw bytes
+        const auto data = reinterpret_cast<const uint8_t *>(bytecode->data());
+        return BytecodeCache::deserialize(js, std::span(data, bytecode->size()));
+    }
+
+    const auto source = store.read_string(path);
+    if (!source) return err(source);
+    return Engine::get(js).bytecode_cache().compile_module(js, *source, name, flags);
+}
+
 auto Engine::JSRuntime_deleter::operator()(JSRuntime *rt) noexcept -> void {
     if (rt == nullptr) return;
     JS_FreeRuntime(rt);
@@ -45,11 +78,16 @@ auto Engine::create(const std::filesystem::path& base_path) noexcept -> Result<s
         else return err(r);
     }
 
+    SPDLOG_TRACE("Opening bytecode cache");
+    const auto cache_dir = BytecodeCache::default_dir();
+    auto bytecode_cache = cache_dir ? BytecodeCache::open(*cache_dir, base_path) : BytecodeCache::disabled();
+
     SPDLOG_TRACE("Allocationg engine");
     auto engine_ptr = owner<Engine *>(new (std::nothrow) Engine {
         std::move(runtime),
         std::move(context),
         std::move(store),
+        std::move(bytecode_cache),
     });
     if (engine_ptr == nullptr) return err("Could not allocate engine");
     auto engine = std::unique_ptr<Engine>(engine_ptr);
@@ -57,6 +95,13 @@ auto Engine::create(const std::filesystem::path& base_path) noexcept -> Result<s
     JS_SetDumpFlags(engine->js_runtime(), JS_DUMP_LEAKS);
     JS_SetRuntimeOpaque(engine->js_runtime(), engine.get());
     JS_SetModuleLoaderFunc(engine->js_runtime(), nullptr, module_loader, engine.get());
+    JS_SetHostPromiseRejectionTracker(
+        engine->js_runtime(),
+        [](JSContext *, JSValueConst promise, JSValueConst reason, bool is_handled, void *opaque) {
+            static_cast<Engine *>(opaque)->track_rejection(promise, reason, is_handled);
+        },
+        engine.get()
+    );
 
     SPDLOG_TRACE("Engine created successfully");
     return engine;
@@ -78,10 +123,18 @@ auto Engine::js_context() const noexcept -> not_null<JSContext *> {
     return _js_context.get().get();
 }
 
+auto Engine::atoms() const noexcept -> const js::AtomTable& {
+    return _atoms;
+}
+
 auto Engine::file_store() noexcept -> IFileStore& {
     return *_file_store;
 }
 
+auto Engine::bytecode_cache() const noexcept -> const BytecodeCache& {
+    return _bytecode_cache;
+}
+
 auto Engine::texture_store() noexcept -> ResourceStore<TextureData>& {
     return _texture_store;
 }
@@ -90,6 +143,26 @@ auto Engine::font_store() noexcept -> ResourceStore<FontData>& {
     return _font_store;
 }
 
+auto Engine::asset_loader() noexcept -> AssetLoader& {
+    return _asset_loader;
+}
+
+auto Engine::timers() noexcept -> TimerQueue& {
+    return _timers;
+}
+
+auto Engine::vector2_pool() noexcept -> SlabPool<::Vector2>& {
+    return _vector2_pool;
+}
+
+auto Engine::rectangle_pool() noexcept -> SlabPool<::Rectangle>& {
+    return _rectangle_pool;
+}
+
+auto Engine::frame() const noexcept -> const FrameState& {
+    return _frame;
+}
+
 auto Engine::register_plugin(const plugins::EnginePlugin& desc) noexcept -> void try {
     for (const auto& [name, module] : desc.c_modules) {
         // TODO: check if already exists
@@ -101,20 +174,24 @@ auto Engine::register_plugin(const plugins::EnginePlugin& desc) noexcept -> void
         _js_modules.insert({name, module});
     }
 
+    const auto zone = [&](std::string_view callback) {
+        return profiler::intern(fmt::format("{}.{}", desc.name, callback));
+    };
+
     if (desc.load != nullptr) {
-        _load_callbacks.emplace_back(desc.load);
+        _load_callbacks.push_back({.zone = zone("load"), .callback = desc.load});
     }
 
     if (desc.unload != nullptr) {
-        _unload_callbacks.emplace_back(desc.unload);
+        _unload_callbacks.push_back({.zone = zone("unload"), .callback = desc.unload});
     }
 
     if (desc.update != nullptr) {
-        _update_callbacks.emplace_back(desc.update);
+        _update_callbacks.push_back({.zone = zone("update"), .callback = desc.update});
     }
 
     if (desc.draw != nullptr) {
-        _draw_callbacks.emplace_back(desc.draw);
+        _draw_callbacks.push_back({.zone = zone("draw"), .callback = desc.draw});
     }
 
     SPDLOG_INFO("Registered `{}` plugin", desc.name);
@@ -124,7 +201,8 @@ auto Engine::register_plugin(const plugins::EnginePlugin& desc) noexcept -> void
 
 auto Engine::load_plugins() noexcept -> Result<> try {
     SPDLOG_DEBUG("Loading plugins");
-    for (const auto& callback : _load_callbacks) {
+    for (const auto& [zone, callback] : _load_callbacks) {
+        auto z = profiler::Zone {zone};
         if (auto result = callback(); !result) return err(result);
     }
     return {};
@@ -132,16 +210,59 @@ auto Engine::load_plugins() noexcept -> Result<> try {
     return err(e);
 }
 
-[[nodiscard]] auto Engine::run_game(Game& game) noexcept -> Result<> try {
+static auto log_resource_stats(std::string_view kind, const ResourceStats& stats) noexcept -> void {
+    constexpr auto MIB = 1024.0 * 1024.0;
+    SPDLOG_INFO(
+        "{}: {} resident ({} cached) using {:.2f} of {:.2f} MiB, {} hits, {} misses, {} evictions",
+        kind,
+        stats.resident,
+        stats.cached,
+        double(stats.resident_bytes) / MIB,
+        double(stats.budget_bytes) / MIB,
+        stats.hits,
+        stats.misses,
+        stats.evictions
+    );
+}
+
+[[nodiscard]] auto Engine::run_game(Game& game, const RunOptions& options) noexcept -> Result<> try {
+    // Written last, so that zones of plugin unloading are in trace
+    _trace_path = options.trace;
+    defer(write_trace());
+
     defer({
+        _timers.clear();
+        _rejections.clear();
+
         SPDLOG_TRACE("Unloading plugins");
-        for (const auto& callback : _unload_callbacks) {
+        for (const auto& [zone, callback] : _unload_callbacks) {
+            auto z = profiler::Zone {zone};
             if (auto result = callback(); !result) {
                 SPDLOG_WARN("Error unloading plugin: {}", result.error()->msg());
             }
         }
     });
 
+    constexpr auto MIB = 1024.0 * 1024.0;
+    _texture_store.set_budget(size_t(game.config().resources.texture_budget * MIB));
+    _font_store.set_budget(size_t(game.config().resources.font_budget * MIB));
+    defer({
+        log_resource_stats("Textures", _texture_store.stats());
+        log_resource_stats("Fonts", _font_store.stats());
+    });
+
+    auto headless = game.config().headless;
+    if (options.headless) headless.enabled = *options.headless;
+    if (options.frames) headless.frames = *options.frames;
+    if (options.dt) headless.dt = *options.dt;
+
+    if (headless.enabled) return run_headless(game, headless.frames, headless.dt);
+    return run_windowed(game);
+} catch (std::exception& e) {
+    return err(e);
+}
+
+[[nodiscard]] auto Engine::run_windowed(Game& game) noexcept -> Result<> try {
     SPDLOG_DEBUG("Creating window");
     auto w = window::create(
         window::Config {
@@ -172,39 +293,275 @@ auto Engine::load_plugins() noexcept -> Result<> try {
         window::close(w);
     });
 
+    SPDLOG_DEBUG("Opening audio device");
+    engine::audio::init();
+    defer({
+        SPDLOG_TRACE("Closing audio device");
+        engine::audio::close();
+    });
+
+    const auto sample_frame = [this]() {
+        _frame.dt = double(GetFrameTime());
+        _frame.time = GetTime();
+        _frame.width = GetScreenWidth();
+        _frame.height = GetScreenHeight();
+    };
+
+    sample_frame();
+
     SPDLOG_DEBUG("Loading game");
     if (auto r = game.load(); !r) return err(r);
 
     SPDLOG_DEBUG("Running rame");
     while (!window::should_close(w)) {
+        auto frame_zone = profiler::Zone {"frame"};
+        sample_frame();
+        run_async_work(game.config().loop.job_budget);
+
         if (IsKeyPressed(KEY_F5)) {
             if (auto r = game.try_reload(); !r) {
                 SPDLOG_ERROR("Exception occured while reloading the game: {}", r.error()->msg());
+            } else {
+                // Time left over from old game would replay as extra substeps of new one
+                _step_accumulator = 0.0;
             }
         }
 
-        SPDLOG_TRACE("Updating plugins");
-        for (const auto& callback : _update_callbacks) {
+        if (IsKeyPressed(KEY_F6)) write_trace();
+
+        if (auto r = update_game(game, double(GetFrameTime())); !r) return err(r);
+
+        window::begin_drawing(w);
+
+        SPDLOG_TRACE("Drawing plugins");
+        for (const auto& [zone, callback] : _draw_callbacks) {
+            auto z = profiler::Zone {zone};
             if (auto r = callback(); !r) return err(r);
         }
 
+        SPDLOG_TRACE("Drawing game");
+        {
+            auto z = profiler::Zone {"game.draw"};
+            if (auto r = game.draw(); !r) return err(r);
+        }
+
+        window::draw_fps(w);
+        profiler::close_open_zones();
+        // Includes waiting for vsync or frame rate limit
+        auto end_zone = profiler::Zone {"end_drawing"};
+        window::end_drawing(w);
+    }
+
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Finish asset loads completed by workers, fire due timers and run promise jobs they queued. Called at frame
+/// boundary, so that GPU uploads and audio buffer creation happen on main thread outside of drawing
+auto Engine::run_async_work(double job_budget) noexcept -> void {
+    if (const auto finished = _asset_loader.pump(); finished > 0) {
+        SPDLOG_TRACE("Finished {} asset loads", finished);
+    }
+
+    {
+        auto z = profiler::Zone {"timers"};
+        _timers.run(js_context(), _frame.time, _frame.dt);
+    }
+
+    auto z = profiler::Zone {"js.jobs"};
+    if (drain_jobs(job_budget)) report_rejections();
+    else SPDLOG_DEBUG("Job budget of {}s exhausted, remaining jobs run next frame", job_budget);
+}
+
+/// Write trace requested by `RunOptions::trace`, if any
+auto Engine::write_trace() noexcept -> void {
+    if (!_trace_path || !profiler::enabled()) return;
+    if (auto r = profiler::write_trace(*_trace_path); !r) {
+        SPDLOG_ERROR("Could not write profiler trace: {}", r.error()->msg());
+    }
+}
+
+auto Engine::drain_jobs(std::optional<double> budget) noexcept -> bool {
+    using Clock = std::chrono::steady_clock;
+
+    const auto deadline = budget ? std::optional {Clock::now() + std::chrono::duration<double>(*budget)} : std::nullopt;
+    auto ctx = static_cast<JSContext *>(nullptr);
+    // At least one job runs every frame, so queue makes progress with any budget
+    for (;;) {
+        const auto r = JS_ExecutePendingJob(js_runtime(), &ctx);
+        if (r == 0) return true;
+        if (r < 0) {
+            const auto error = js::JSError::from_value(js::own(ctx, JS_GetException(ctx)));
+            SPDLOG_ERROR("Uncaught exception in pending job: {}", error.msg());
+        }
+        if (deadline && Clock::now() >= *deadline) return !JS_IsJobPending(js_runtime());
+    }
+}
+
+auto Engine::track_rejection(JSValueConst promise, JSValueConst reason, bool is_handled) noexcept -> void try {
+    if (is_handled) {
+        // Handler was attached later in same job queue run, rejection is not reported
+        std::erase_if(_rejections, [&](const UnhandledRejection& r) {
+            return JS_VALUE_GET_PTR(r.promise.cget()) == JS_VALUE_GET_PTR(promise);
+        });
+        return;
+    }
+    _rejections.push_back({
+        .promise = js::own(js_context(), JS_DupValue(js_context(), promise)),
+        .reason = js::own(js_context(), JS_DupValue(js_context(), reason)),
+    });
+} catch (std::exception& e) {
+    SPDLOG_ERROR("Unexpected C++ exception while tracking promise rejection: {}", e.what());
+}
+
+auto Engine::report_rejections() noexcept -> void {
+    for (const auto& rejection : _rejections) {
+        SPDLOG_ERROR("Unhandled promise rejection: {}", js::JSError::from_value(rejection.reason).msg());
+    }
+    _rejections.clear();
+}
+
+auto Engine::await_promise(JSValueConst promise) noexcept -> Result<> try {
+    using namespace std::chrono_literals;
+
+    while (JS_PromiseState(js_context(), promise) == JS_PROMISE_PENDING) {
+        drain_jobs(std::nullopt);
+        if (JS_PromiseState(js_context(), promise) != JS_PROMISE_PENDING) break;
+        if (_asset_loader.pending() == 0) {
+            return err("Promise can not settle before game loop starts, it is waiting for a timer or frame");
+        }
+        if (_asset_loader.pump() == 0) std::this_thread::sleep_for(1ms);
+    }
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Update plugins once and game either once with frame time or, with fixed step loop, zero or more times.
+/// When game falls behind more than `max_substeps`, remaining steps are dropped to avoid spiral of death.
+[[nodiscard]] auto Engine::update_game(Game& game, double frame_dt) noexcept -> Result<> try {
+    SPDLOG_TRACE("Updating plugins");
+    for (const auto& [zone, callback] : _update_callbacks) {
+        auto z = profiler::Zone {zone};
+        if (auto r = callback(); !r) return err(r);
+    }
+
+    const auto& loop = game.config().loop;
+    if (!loop.fixed_step) {
+        _frame.dt = frame_dt;
+        _frame.alpha = 1.0;
         SPDLOG_TRACE("Updating game");
+        auto z = profiler::Zone {"game.update"};
         if (auto r = game.update(); !r) return err(r);
+        return {};
+    }
 
-        window::begin_drawing(w);
+    const auto step = *loop.fixed_step;
+    _frame.dt = step;
+    _step_accumulator += frame_dt;
+
+    auto substeps = 0;
+    while (_step_accumulator >= step && substeps < loop.max_substeps) {
+        SPDLOG_TRACE("Updating game, substep {}", substeps);
+        auto z = profiler::Zone {"game.update"};
+        if (auto r = game.update(); !r) return err(r);
+        _step_accumulator -= step;
+        substeps++;
+    }
+
+    if (_step_accumulator >= step) {
+        SPDLOG_DEBUG("Simulation is behind, dropping {} substeps", int(_step_accumulator / step));
+        _step_accumulator = std::fmod(_step_accumulator, step);
+    }
+
+    _frame.alpha = _step_accumulator / step;
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Run game without window and audio device for a fixed number of frames, advancing time by `dt` each frame.
+/// Plugin and game draw callbacks are still called, so draw-side state is exercised, but graphics bindings skip
+/// GPU work without a window.
+/// Prints frame time statistics when done.
+[[nodiscard]] auto Engine::run_headless(Game& game, int frames, double dt) noexcept -> Result<> try {
+    using Clock = std::chrono::steady_clock;
+    using Millis = std::chrono::duration<double, std::milli>;
+
+    if (frames <= 0) return err(std::format("Headless frame count must be positive, got {}", frames));
+    if (dt <= 0.0) return err(std::format("Headless frame dt must be positive, got {}", dt));
+
+    SPDLOG_DEBUG("Running game headless for {} frames with dt = {}", frames, dt);
+    _frame = FrameState {
+        .dt = dt,
+        .time = 0.0,
+        .alpha = 1.0,
+        .width = game.config().window.width,
+        .height = game.config().window.height,
+    };
+
+    SPDLOG_DEBUG("Loading game");
+    if (auto r = game.load(); !r) return err(r);
+
+    auto frame_times = std::vector<double>(size_t(frames));
+    auto update_total = Millis {};
+    auto draw_total = Millis {};
+
+    for (auto& frame_time : frame_times) {
+        auto frame_zone = profiler::Zone {"frame"};
+        const auto frame_start = Clock::now();
+
+        run_async_work(game.config().loop.job_budget);
+
+        if (auto r = update_game(game, dt); !r) return err(r);
+
+        const auto update_end = Clock::now();
 
         SPDLOG_TRACE("Drawing plugins");
-        for (const auto& callback : _draw_callbacks) {
+        for (const auto& [zone, callback] : _draw_callbacks) {
+            auto z = profiler::Zone {zone};
             if (auto r = callback(); !r) return err(r);
         }
 
         SPDLOG_TRACE("Drawing game");
-        if (auto r = game.draw(); !r) return err(r);
+        {
+            auto z = profiler::Zone {"game.draw"};
+            if (auto r = game.draw(); !r) return err(r);
+        }
 
-        window::draw_fps(w);
-        window::end_drawing(w);
+        const auto draw_end = Clock::now();
+        profiler::close_open_zones();
+
+        update_total += update_end - frame_start;
+        draw_total += draw_end - update_end;
+        frame_time = Millis(draw_end - frame_start).count();
+
+        _frame.time += dt;
     }
 
+    const auto total = (update_total + draw_total).count();
+    std::ranges::sort(frame_times);
+    const auto percentile = [&](double p) {
+        return frame_times[std::min(frame_times.size() - 1, size_t(p * double(frame_times.size())))];
+    };
+
+    fmt::println("Headless run: {} frames, dt = {:.4f} s", frames, dt);
+    fmt::println(
+        "Frame time (ms): min {:.3f}, p50 {:.3f}, p99 {:.3f}, max {:.3f}",
+        frame_times.front(),
+        percentile(0.50),
+        percentile(0.99),
+        frame_times.back()
+    );
+    fmt::println(
+        "Total (ms): update {:.3f}, draw {:.3f}, frame {:.3f} ({:.1f} frames/s)",
+        update_total.count(),
+        draw_total.count(),
+        total,
+        total > 0.0 ? double(frames) * 1000.0 / total : 0.0
+    );
+
     return {};
 } catch (std::exception& e) {
     return err(e);
@@ -215,10 +572,11 @@ auto Engine::load_module(const std::filesystem::path& name) noexcept -> Result<o
         SPDLOG_DEBUG("Module {} resolved as builtin native module", name.string());
         return cm->second;
     } else {
-        auto code = std::string {};
+        auto zone = profiler::Zone {"module.load", name.string()};
+        auto ret = JSValue {};
         if (auto jm = _js_modules.find(name); jm != _js_modules.end()) {
             SPDLOG_DEBUG("Module {} resolved as builtin js module", name.string());
-            code = jm->second;
+            ret = _bytecode_cache.compile_module(js_context(), jm->second, name.string());
         } else {
             auto path = name;
             // TODO: error handling
@@ -226,20 +584,12 @@ auto Engine::load_module(const std::filesystem::path& name) noexcept -> Result<o
                 path += ".js";
             }
             SPDLOG_TRACE("Loading module {}", path.string());
-            const auto contents = _file_store->read_string(path);
-            if (!contents) return err(contents);
+            auto compiled = compile_game_module(js_context(), *_file_store, path, name.string(), 0);
+            if (!compiled) return err(compiled);
             SPDLOG_DEBUG("Module {} resolved as game module", name.string());
-            code = *contents;
+            ret = *compiled;
         }
 
-        JSValue ret = JS_Eval(
-            js_context(),
-            code.c_str(),
-            code.size(),
-            name.string().c_str(),
-            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY
-        );
-
         if (JS_IsException(ret)) return nullptr;
         auto mod = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(ret));
         JS_FreeValue(js_context(), ret);
@@ -253,35 +603,35 @@ auto Engine::load_module(const std::filesystem::path& name) noexcept -> Result<o
 Engine::Engine(
     std::unique_ptr<JSRuntime, JSRuntime_deleter>&& runtime,
     std::unique_ptr<JSContext, JSContext_deleter>&& context,
-    std::unique_ptr<IFileStore>&& store
+    std::unique_ptr<IFileStore>&& store,
+    BytecodeCache&& bytecode_cache
 ) noexcept :
     _file_store {std::move(store)},
+    _bytecode_cache {std::move(bytecode_cache)},
     _js_runtime {std::move(runtime)},
-    _js_context {std::move(context)} {}
+    _js_context {std::move(context)},
+    _atoms {_js_context.get().get()} {}
 
 auto Game::create(not_null<JSContext *> js, not_null<IFileStore *> store) -> Result<Game> {
     SPDLOG_TRACE("Creating game");
 
-    SPDLOG_TRACE("Reading game file");
-    const auto src = store->read_string("game.js");
-    if (!src) return err(src);
-
     SPDLOG_TRACE("Compiling game module");
-    auto mod = JS_Eval(
-        js,
-        src->c_str(),
-        src->size(),
-        "game.js",
-        JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY
-    );
+    const auto compiled = compile_game_module(js, *store, "game.js", "game.js", JS_EVAL_FLAG_STRICT);
+    if (!compiled) return err(compiled);
+    auto mod = *compiled;
     if (JS_HasException(js)) return err(js::JSError::from_value(js::own(js, JS_GetException(js))));
 
     SPDLOG_TRACE("Evaluating game module");
     auto eval_ret = JS_EvalFunction(js, mod);
     defer(JS_FreeValue(js, eval_ret));
-    auto eval_result = JS_PromiseResult(js, eval_ret);
-    if (JS_IsError(eval_result)) return err(js::JSError::from_value(js::own(js, eval_result)));
-    JS_FreeValue(js, eval_result);
+    if (JS_IsException(eval_ret)) return err(js::JSError::from_value(js::own(js, JS_GetException(js))));
+    // Module with top-level await evaluates asynchronously
+    if (auto r = Engine::get(js).await_promise(eval_ret); !r) return err(r);
+    if (JS_PromiseState(js, eval_ret) == JS_PROMISE_REJECTED) {
+        // Reported here as module error, not as unhandled rejection
+        Engine::get(js).track_rejection(eval_ret, JS_UNDEFINED, true);
+        return err(js::JSError::from_value(js::own(js, JS_PromiseResult(js, eval_ret))));
+    }
 
     auto m = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(mod));
     auto ns_prop = JS_GetModuleNamespace(js, m);
@@ -363,8 +713,7 @@ auto Game::try_reload() noexcept -> Result<> try {
     if (new_game._post_reload) {
         SPDLOG_TRACE("New game has postReload, so calling it");
         if (state) {
-            auto args = std::array {*state};
-            if (auto r = new_game._post_reload->operator()(args); !r) return err(r);
+            if (auto r = new_game._post_reload->call(JS_UNDEFINED, *state); !r) return err(r);
         } else {
             if (auto r = new_game._post_reload->operator()(); !r) return err(r);
         }
@@ -415,6 +764,45 @@ auto read_config(js::Object& ns) -> Result<GameConfig> {
     auto obj_opt = std::move(*obj_result);
     if (!obj_opt) return config;
     auto obj = std::move(*obj_opt);
+
+    auto headless_obj_result = obj.at<std::optional<js::Object>>("headless");
+    if (!headless_obj_result) return err(headless_obj_result);
+    if (headless_obj_result->has_value()) {
+        auto headless_obj = std::move(**headless_obj_result);
+        glint_GAMECONFIG_READ_OPTIONAL(headless_obj, config.headless.enabled, enabled);
+        glint_GAMECONFIG_READ_OPTIONAL(headless_obj, config.headless.frames, frames);
+        glint_GAMECONFIG_READ_OPTIONAL(headless_obj, config.headless.dt, dt);
+    }
+
+    auto loop_obj_result = obj.at<std::optional<js::Object>>("loop");
+    if (!loop_obj_result) return err(loop_obj_result);
+    if (loop_obj_result->has_value()) {
+        auto loop_obj = std::move(**loop_obj_result);
+        auto fixed_step = 0.0;
+        glint_GAMECONFIG_READ_OPTIONAL(loop_obj, fixed_step, fixedStep);
+        if (fixed_step < 0.0) return err(std::format("config.loop.fixedStep must not be negative, got {}", fixed_step));
+        if (fixed_step > 0.0) config.loop.fixed_step = fixed_step;
+        glint_GAMECONFIG_READ_OPTIONAL(loop_obj, config.loop.max_substeps, maxSubsteps);
+        if (config.loop.max_substeps < 1) {
+            return err(std::format("config.loop.maxSubsteps must be at least 1, got {}", config.loop.max_substeps));
+        }
+        glint_GAMECONFIG_READ_OPTIONAL(loop_obj, config.loop.job_budget, jobBudget);
+        if (config.loop.job_budget <= 0.0) {
+            return err(std::format("config.loop.jobBudget must be positive, got {}", config.loop.job_budget));
+        }
+    }
+
+    auto resources_obj_result = obj.at<std::optional<js::Object>>("resources");
+    if (!resources_obj_result) return err(resources_obj_result);
+    if (resources_obj_result->has_value()) {
+        auto resources_obj = std::move(**resources_obj_result);
+        glint_GAMECONFIG_READ_OPTIONAL(resources_obj, config.resources.texture_budget, textureBudget);
+        glint_GAMECONFIG_READ_OPTIONAL(resources_obj, config.resources.font_budget, fontBudget);
+        if (config.resources.texture_budget < 0.0 || config.resources.font_budget < 0.0) {
+            return err("config.resources budgets must not be negative");
+        }
+    }
+
     auto window_obj_result = obj.at<std::optional<js::Object>>("window");
     if (!window_obj_result) return err(window_obj_result);
     if (!window_obj_result->has_value()) return config;
@@ -447,5 +835,6 @@ auto read_config(js::Object& ns) -> Result<GameConfig> {
 
 #include "./engine/audio.cpp"
 #include "./engine/music.cpp"
+#include "./engine/music_stream.cpp"
 #include "./engine/sound.cpp"
 #include "./engine/window.cpp"
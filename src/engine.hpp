@@ -1,17 +1,22 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 
 #include <gsl/gsl>
 #include <spdlog/spdlog.h>
 
+#include <asset_loader.hpp>
+#include <bytecode_cache.hpp>
 #include <quickjs.hpp>
 #include <types.hpp>
 #include <engine/plugin.hpp>
 #include <error.hpp>
 #include <file_store.hpp>
 #include <resource_store.hpp>
+#include <slab_pool.hpp>
+#include <timers.hpp>
 #include <data.hpp>
 
 namespace glint {
@@ -21,8 +26,38 @@ using namespace gsl;
 class Game;
 class Engine;
 
+/// Command line overrides for `GameConfig`
+struct RunOptions {
+    /// Run without window and audio device. Update and draw callbacks still run, GPU calls are skipped
+    std::optional<bool> headless = std::nullopt;
+    std::optional<int> frames = std::nullopt;
+    std::optional<double> dt = std::nullopt;
+    /// Write Chrome trace of profiler zones here on exit and on F6. Profiler has to be enabled
+    std::optional<std::filesystem::path> trace = std::nullopt;
+};
+
+/// Per-frame values exposed to game through `glint:screen`
+struct FrameState {
+    double dt = 0.0;
+    double time = 0.0;
+    double alpha = 1.0;
+    int width = 0;
+    int height = 0;
+};
+
 class Engine {
   private:
+    struct UnhandledRejection {
+        js::Value promise;
+        js::Value reason;
+    };
+
+    struct PluginCallback {
+        /// Profiler zone name, `<plugin>.<callback>`
+        const char *zone;
+        std::function<auto()->Result<>> callback;
+    };
+
     struct JSRuntime_deleter {
         auto operator()(JSRuntime *rt) noexcept -> void;
     };
@@ -33,18 +68,30 @@ class Engine {
 
   private:
     not_null<std::unique_ptr<IFileStore>> _file_store;
+    BytecodeCache _bytecode_cache;
     ResourceStore<TextureData> _texture_store {};
     ResourceStore<FontData> _font_store {};
+    SlabPool<::Vector2> _vector2_pool {};
+    SlabPool<::Rectangle> _rectangle_pool {};
 
     not_null<std::unique_ptr<JSRuntime, JSRuntime_deleter>> _js_runtime;
     not_null<std::unique_ptr<JSContext, JSContext_deleter>> _js_context;
+    js::AtomTable _atoms;
+    // Pending tasks hold JS values and use file store, so loader must be destroyed first
+    AssetLoader _asset_loader {};
+    TimerQueue _timers {};
+    std::vector<UnhandledRejection> _rejections {};
 
     std::unordered_map<std::filesystem::path, std::string> _js_modules {};
     std::unordered_map<std::filesystem::path, JSModuleDef *> _c_modules {};
-    std::vector<std::function<auto()->Result<>>> _load_callbacks {};
-    std::vector<std::function<auto()->Result<>>> _unload_callbacks {};
-    std::vector<std::function<auto()->Result<>>> _update_callbacks {};
-    std::vector<std::function<auto()->Result<>>> _draw_callbacks {};
+    std::vector<PluginCallback> _load_callbacks {};
+    std::vector<PluginCallback> _unload_callbacks {};
+    std::vector<PluginCallback> _update_callbacks {};
+    std::vector<PluginCallback> _draw_callbacks {};
+
+    FrameState _frame {};
+    std::optional<std::filesystem::path> _trace_path {};
+    double _step_accumulator = 0.0;
 
   public:
     [[nodiscard]]
@@ -62,15 +109,38 @@ class Engine {
     [[nodiscard]]
     auto js_context() const noexcept -> not_null<JSContext *>;
 
+    [[nodiscard]]
+    auto atoms() const noexcept -> const js::AtomTable&;
+
     [[nodiscard]]
     auto file_store() noexcept -> IFileStore&;
 
+    [[nodiscard]]
+    auto bytecode_cache() const noexcept -> const BytecodeCache&;
+
     [[nodiscard]]
     auto texture_store() noexcept -> ResourceStore<TextureData>&;
 
     [[nodiscard]]
     auto font_store() noexcept -> ResourceStore<FontData>&;
 
+    [[nodiscard]]
+    auto asset_loader() noexcept -> AssetLoader&;
+
+    [[nodiscard]]
+    auto timers() noexcept -> TimerQueue&;
+
+    /// Storage for Vector2 object opaques. Must outlive JS runtime
+    [[nodiscard]]
+    auto vector2_pool() noexcept -> SlabPool<::Vector2>&;
+
+    /// Storage for Rectangle object opaques. Must outlive JS runtime
+    [[nodiscard]]
+    auto rectangle_pool() noexcept -> SlabPool<::Rectangle>&;
+
+    [[nodiscard]]
+    auto frame() const noexcept -> const FrameState&;
+
     /// Register plugin to engine
     auto register_plugin(const plugins::EnginePlugin& desc) noexcept -> void;
 
@@ -79,16 +149,43 @@ class Engine {
 
     /// Run game using engine
     [[nodiscard]]
-    auto run_game(Game& game) noexcept -> Result<>;
+    auto run_game(Game& game, const RunOptions& options = {}) noexcept -> Result<>;
 
     [[nodiscard]]
     auto load_module(const std::filesystem::path& path) noexcept -> Result<owner<JSModuleDef *>>;
 
+    /// Run jobs and finish asset loads until promise settles. Meant for module evaluation before game loop starts,
+    /// so fails instead of waiting for timers or frames that would never come
+    [[nodiscard]]
+    auto await_promise(JSValueConst promise) noexcept -> Result<>;
+
+    /// Host promise rejection tracker. Rejections still unhandled once job queue is drained are reported
+    auto track_rejection(JSValueConst promise, JSValueConst reason, bool is_handled) noexcept -> void;
+
   private:
+    [[nodiscard]]
+    auto run_windowed(Game& game) noexcept -> Result<>;
+
+    auto run_async_work(double job_budget) noexcept -> void;
+
+    auto write_trace() noexcept -> void;
+
+    /// Execute pending jobs until queue is empty or `budget` seconds have passed. Returns whether queue is empty
+    auto drain_jobs(std::optional<double> budget) noexcept -> bool;
+
+    auto report_rejections() noexcept -> void;
+
+    [[nodiscard]]
+    auto update_game(Game& game, double frame_dt) noexcept -> Result<>;
+
+    [[nodiscard]]
+    auto run_headless(Game& game, int frames, double dt) noexcept -> Result<>;
+
     Engine(
         std::unique_ptr<JSRuntime, JSRuntime_deleter>&& runtime,
         std::unique_ptr<JSContext, JSContext_deleter>&& context,
-        std::unique_ptr<IFileStore>&& store
+        std::unique_ptr<IFileStore>&& store,
+        BytecodeCache&& bytecode_cache
     ) noexcept;
 };
 
@@ -115,8 +212,30 @@ struct GameWindowConfig {
     bool interlaced_hint = false;
 };
 
+struct GameHeadlessConfig {
+    bool enabled = false;
+    int frames = 600;
+    double dt = 1.0 / 60.0;
+};
+
+struct GameLoopConfig {
+    std::optional<double> fixed_step = std::nullopt;
+    int max_substeps = 8;
+    /// Seconds per frame spent running promise jobs, rest of queue waits for next frame
+    double job_budget = 0.004;
+};
+
+/// Memory budgets in MiB. Unreferenced resources are evicted when store goes over its budget
+struct GameResourcesConfig {
+    double texture_budget = 256.0;
+    double font_budget = 32.0;
+};
+
 struct GameConfig {
     GameWindowConfig window;
+    GameHeadlessConfig headless;
+    GameLoopConfig loop;
+    GameResourcesConfig resources;
 };
 
 class Game {
@@ -1,26 +1,127 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <gsl/gsl>
+#include <memory>
 #include <set>
+#include <span>
+#include <vector>
 
 #include <error.hpp>
 #include <file_store.hpp>
 #include <raylib.hpp>
 
+struct OggVorbis_File;
+
 namespace glint::engine::audio {
 
 using namespace gsl;
 
 namespace music {
+    /// Sequential reader with fixed size ring buffer of read ahead bytes in front of store file
+    class RingReader {
+      public:
+        static constexpr size_t CAPACITY = 64ul * 1024ul;
+
+      private:
+        std::unique_ptr<IFileReader> _file;
+        std::unique_ptr<char[]> _ring;
+        size_t _head = 0;
+        size_t _size = 0;
+
+      public:
+        explicit RingReader(std::unique_ptr<IFileReader> file);
+
+        /// Read up to `buf.size()` bytes, returns 0 at end of file or on error
+        auto read(std::span<char> buf) noexcept -> size_t;
+
+        /// Seek like `fseek`, reusing buffered bytes when target is inside them
+        auto seek(int64_t offset, int whence) noexcept -> bool;
+
+        [[nodiscard]]
+        auto tell() const noexcept -> int64_t;
+
+      private:
+        auto fill() noexcept -> bool;
+    };
+
+    /// Ogg Vorbis music decoded on main thread while playing. Compressed data is pulled from store in chunks, so
+    /// resident memory does not depend on music length
+    class Stream {
+      public:
+        /// Frames decoded per audio stream update
+        static constexpr size_t FRAMES = 4096;
+
+      private:
+        RingReader _reader;
+        std::unique_ptr<OggVorbis_File> _vorbis;
+        rl::AudioStream _audio {};
+        std::vector<int16_t> _pcm {};
+        bool _ended = false;
+        bool _drained = false;
+
+      public:
+        bool looping = true;
+
+        /// Whether file can be streamed judging by extension
+        [[nodiscard]]
+        static auto supports(const std::filesystem::path& name) noexcept -> bool;
+
+        /// Open decoder and read stream headers. Does not touch audio device, so it can run on worker thread
+        [[nodiscard]]
+        static auto open(std::unique_ptr<IFileReader> file) noexcept -> Result<std::unique_ptr<Stream>>;
+
+        /// Create audio stream music is played through. Must be called on main thread before playing
+        [[nodiscard]]
+        auto create_audio_stream() noexcept -> Result<>;
+
+        /// Refill processed audio buffers, stops stream after last frame is played unless looping
+        auto update() noexcept -> void;
+        auto play() noexcept -> void;
+        auto stop() noexcept -> void;
+        auto seek(float cursor) noexcept -> void;
+
+        [[nodiscard]]
+        auto audio() const noexcept -> const ::AudioStream& {
+            return _audio;
+        }
+
+        Stream(const Stream&) = delete;
+        Stream(Stream&&) = delete;
+        auto operator=(const Stream&) -> Stream& = delete;
+        auto operator=(Stream&&) -> Stream& = delete;
+        ~Stream() noexcept;
+
+      private:
+        explicit Stream(std::unique_ptr<IFileReader> file);
+
+        auto decode() noexcept -> size_t;
+        auto rewind() noexcept -> void;
+    };
+
     struct Music {
         rl::Music music {};
-        std::unique_ptr<unsigned char[]> data;
+        /// Compressed data of music decoded by raylib, decoder keeps reading from it while playing
+        MappedBuffer data {};
+        /// Set instead of `music` when music is streamed from store
+        std::unique_ptr<Stream> stream {};
         float volume = 1.0f;
         float pitch = 1.0f;
         float pan = 0.5f;
     };
 
+    /// Music file opened by `prepare`, either as decoder stream or as data for raylib
+    struct Source {
+        std::filesystem::path name;
+        MappedBuffer data {};
+        std::unique_ptr<Stream> stream {};
+    };
+
+    /// Read or open music file. Does not touch audio device, so it can run on worker thread
+    auto prepare(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Source>;
+    /// Create music from prepared source on main thread
+    auto finish(Source&& source) noexcept -> Result<Music>;
     auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Music>;
     auto update(Music& self) noexcept -> void;
     auto play(Music& self) noexcept -> void;
@@ -47,6 +148,10 @@ namespace sound {
         float pan = 0.5f;
     };
 
+    /// Read and decode sound file into samples. Does not touch audio device, so it can run on worker thread
+    auto decode(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<rl::Wave>;
+    /// Create sound from decoded samples on main thread
+    auto from_wave(const rl::Wave& wave) noexcept -> Sound;
     auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Sound>;
     auto play(Sound& self) noexcept -> void;
     auto stop(Sound& self) noexcept -> void;
@@ -9,57 +9,100 @@ namespace glint::engine::audio::music {
 
 using namespace gsl;
 
-auto load(const std::filesystem::path& name, IFileStore &store) noexcept -> Result<Music> {
-    auto data = store.read_bytes(name);
+static auto open_stream(const std::filesystem::path& name, IFileStore& store) noexcept
+    -> Result<std::unique_ptr<Stream>> {
+    auto file = store.open_file(name);
+    if (!file) return err(file);
+    return Stream::open(std::move(*file));
+}
+
+auto prepare(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Source> try {
+    if (::IsAudioDeviceReady() && Stream::supports(name)) {
+        if (auto stream = open_stream(name, store)) {
+            SPDLOG_DEBUG("Streaming music {}", name.string());
+            return Source {.name = name, .stream = std::move(*stream)};
+        } else {
+            SPDLOG_DEBUG("Music {} can not be streamed: {}", name.string(), stream.error()->msg());
+        }
+    }
+
+    auto data = store.map(name);
     if (!data) return err(data);
-    auto buf = std::make_unique<unsigned char[]>(data->size());
-    std::ranges::copy(*data, buf.get());
-    auto span = std::span{buf.get(), data->size()};
-    auto raylib_music = rl::Music::load_from_memory(name.extension().string().c_str(), span);
-
-    auto music = Music {.music = std::move(raylib_music), .data = std::move(buf)};
-
-    SetMusicVolume(music.music, music.volume);
-    SetMusicPan(music.music, music.pan);
-    SetMusicPitch(music.music, music.pitch);
+    return Source {.name = name, .data = std::move(*data)};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto finish(Source&& source) noexcept -> Result<Music> {
+    auto music = Music {};
+    if (source.stream) {
+        if (auto r = source.stream->create_audio_stream(); !r) return err(r);
+        music.stream = std::move(source.stream);
+    } else {
+        // Without audio device (headless run) music stays empty, raylib ignores calls on it
+        if (::IsAudioDeviceReady()) {
+            const auto extension = source.name.extension().string();
+            music.music = rl::Music::load_from_memory(extension.c_str(), source.data.bytes());
+        }
+        music.data = std::move(source.data);
+    }
+
+    set_volume(music, music.volume);
+    set_pan(music, music.pan);
+    set_pitch(music, music.pitch);
 
     return music;
 }
 
+auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Music> {
+    auto source = prepare(name, store);
+    if (!source) return err(source);
+    return finish(std::move(*source));
+}
+
 auto update(Music& self) noexcept -> void {
-    UpdateMusicStream(self.music);
+    if (self.stream) self.stream->update();
+    else UpdateMusicStream(self.music);
 }
 
 auto play(Music& self) noexcept -> void {
-    PlayMusicStream(self.music);
+    if (self.stream) self.stream->play();
+    else PlayMusicStream(self.music);
 }
 
 auto stop(Music& self) noexcept -> void {
-    StopMusicStream(self.music);
+    if (self.stream) self.stream->stop();
+    else StopMusicStream(self.music);
 }
 
 auto pause(Music& self) noexcept -> void {
-    PauseMusicStream(self.music);
+    if (self.stream) PauseAudioStream(self.stream->audio());
+    else PauseMusicStream(self.music);
 }
 
 auto resume(Music& self) noexcept -> void {
-    ResumeMusicStream(self.music);
+    if (self.stream) ResumeAudioStream(self.stream->audio());
+    else ResumeMusicStream(self.music);
 }
 
 auto seek(Music& self, float cursor) noexcept -> void {
-    SeekMusicStream(self.music, cursor);
+    if (self.stream) self.stream->seek(cursor);
+    else SeekMusicStream(self.music, cursor);
 }
 
 auto is_playing(const Music& self) noexcept -> bool {
+    if (self.stream) return IsAudioStreamPlaying(self.stream->audio());
     return IsMusicStreamPlaying(self.music);
 }
 
 auto get_looping(const Music& self) noexcept -> bool {
+    if (self.stream) return self.stream->looping;
     return self.music.looping;
 }
 
 auto set_looping(Music& self, bool looping) noexcept -> void {
-    self.music.looping = looping;
+    if (self.stream) self.stream->looping = looping;
+    else self.music.looping = looping;
 }
 
 auto get_volume(const Music& self) noexcept -> float {
@@ -68,7 +111,8 @@ auto get_volume(const Music& self) noexcept -> float {
 
 auto set_volume(Music& self, float volume) noexcept -> void {
     self.volume = std::clamp(volume, 0.0f, 1.0f);
-    SetMusicVolume(self.music, self.volume);
+    if (self.stream) SetAudioStreamVolume(self.stream->audio(), self.volume);
+    else SetMusicVolume(self.music, self.volume);
 }
 
 auto get_pan(const Music& self) noexcept -> float {
@@ -77,7 +121,8 @@ auto get_pan(const Music& self) noexcept -> float {
 
 auto set_pan(Music& self, float pan) noexcept -> void {
     self.pan = std::clamp(pan, 0.0f, 1.0f);
-    SetMusicPan(self.music, self.pan);
+    if (self.stream) SetAudioStreamPan(self.stream->audio(), self.pan);
+    else SetMusicPan(self.music, self.pan);
 }
 
 auto get_pitch(const Music& self) noexcept -> float {
@@ -86,7 +131,8 @@ auto get_pitch(const Music& self) noexcept -> float {
 
 auto set_pitch(Music& self, float pitch) noexcept -> void {
     self.pitch = pitch;
-    ::SetMusicPitch(self.music, self.pitch);
+    if (self.stream) SetAudioStreamPitch(self.stream->audio(), self.pitch);
+    else SetMusicPitch(self.music, self.pitch);
 }
 
 } // namespace glint::engine::audio::music
@@ -0,0 +1,228 @@
+#include "./audio.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <vorbis/vorbisfile.h>
+
+namespace glint::engine::audio::music {
+
+RingReader::RingReader(std::unique_ptr<IFileReader> file) :
+    _file(std::move(file)),
+    _ring(std::make_unique<char[]>(CAPACITY)) {}
+
+auto RingReader::read(std::span<char> buf) noexcept -> size_t {
+    auto done = size_t {};
+    while (done < buf.size()) {
+        if (_size == 0 && !fill()) break;
+        const auto n = std::min({buf.size() - done, _size, CAPACITY - _head});
+        std::memcpy(buf.data() + done, _ring.get() + _head, n);
+        _head = (_head + n) % CAPACITY;
+        _size -= n;
+        done += n;
+    }
+    return done;
+}
+
+auto RingReader::seek(int64_t offset, int whence) noexcept -> bool {
+    const auto size = int64_t(_file->size());
+    const auto current = tell();
+    auto target = offset;
+    if (whence == SEEK_CUR) target += current;
+    else if (whence == SEEK_END) target += size;
+    if (target < 0 || target > size) return false;
+
+    // Decoder often skips forward a little, which only drops buffered bytes
+    if (target >= current && target - current <= int64_t(_size)) {
+        const auto skip = size_t(target - current);
+        _head = (_head + skip) % CAPACITY;
+        _size -= skip;
+        return true;
+    }
+
+    if (auto result = _file->seek(uint64_t(target)); !result) {
+        SPDLOG_WARN("Could not seek music stream: {}", result.error()->msg());
+        return false;
+    }
+    _head = 0;
+    _size = 0;
+    return true;
+}
+
+auto RingReader::tell() const noexcept -> int64_t {
+    return int64_t(_file->tell() - _size);
+}
+
+auto RingReader::fill() noexcept -> bool {
+    if (_size == 0) _head = 0;
+    const auto tail = (_head + _size) % CAPACITY;
+    // Free space may wrap around, only contiguous part is filled
+    const auto free = tail >= _head ? CAPACITY - tail : _head - tail;
+    if (_size == CAPACITY || free == 0) return true;
+
+    auto n = _file->read(std::span(_ring.get() + tail, free));
+    if (!n) {
+        SPDLOG_WARN("Could not read music stream: {}", n.error()->msg());
+        return false;
+    }
+    _size += *n;
+    return *n > 0;
+}
+
+static auto vorbis_read(void *ptr, size_t size, size_t count, void *source) -> size_t {
+    if (size == 0) return 0;
+    auto reader = static_cast<RingReader *>(source);
+    return reader->read(std::span(static_cast<char *>(ptr), size * count)) / size;
+}
+
+static auto vorbis_seek(void *source, ogg_int64_t offset, int whence) -> int {
+    return static_cast<RingReader *>(source)->seek(int64_t(offset), whence) ? 0 : -1;
+}
+
+static auto vorbis_tell(void *source) -> long {
+    return long(static_cast<RingReader *>(source)->tell());
+}
+
+static const auto VORBIS_CALLBACKS = ov_callbacks {
+    .read_func = vorbis_read,
+    .seek_func = vorbis_seek,
+    .close_func = nullptr,
+    .tell_func = vorbis_tell,
+};
+
+auto Stream::supports(const std::filesystem::path& name) noexcept -> bool try {
+    auto extension = name.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return extension == ".ogg";
+} catch (...) {
+    return false;
+}
+
+auto Stream::open(std::unique_ptr<IFileReader> file) noexcept -> Result<std::unique_ptr<Stream>> try {
+    auto stream = std::unique_ptr<Stream>(new Stream {std::move(file)});
+
+    const auto vorbis = stream->_vorbis.get();
+    if (const auto code = ov_open_callbacks(&stream->_reader, vorbis, nullptr, 0, VORBIS_CALLBACKS); code < 0) {
+        return err(fmt::format("Not an Ogg Vorbis stream (error {})", code));
+    }
+
+    const auto info = ov_info(vorbis, -1);
+    if (info == nullptr || info->channels < 1 || info->channels > 2) {
+        return err("Only mono and stereo Ogg Vorbis music can be streamed");
+    }
+
+    stream->_pcm.resize(FRAMES * size_t(info->channels));
+    return stream;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto Stream::create_audio_stream() noexcept -> Result<> {
+    const auto info = ov_info(_vorbis.get(), -1);
+    if (info == nullptr) return err("Music stream is not open");
+
+    // Both halves of stream buffer get default size, so every update pushes exactly one half
+    ::SetAudioStreamBufferSizeDefault(int {FRAMES});
+    _audio = rl::AudioStream::load(unsigned(info->rate), 16, unsigned(info->channels));
+    ::SetAudioStreamBufferSizeDefault(0);
+    if (!::IsAudioStreamValid(_audio)) return err("Could not create audio stream");
+
+    return {};
+}
+
+auto Stream::update() noexcept -> void {
+    while (::IsAudioStreamProcessed(_audio)) {
+        if (_ended) {
+            // Last frames are still queued in the other half of buffer, stop after it has been played too
+            if (_drained) {
+                stop();
+                return;
+            }
+            std::ranges::fill(_pcm, int16_t {0});
+            _drained = true;
+        } else {
+            const auto frames = decode();
+            if (frames < FRAMES) {
+                std::fill(_pcm.begin() + ptrdiff_t(frames * _audio.channels), _pcm.end(), int16_t {0});
+                _ended = true;
+            }
+        }
+        ::UpdateAudioStream(_audio, _pcm.data(), int {FRAMES});
+    }
+}
+
+auto Stream::play() noexcept -> void {
+    ::PlayAudioStream(_audio);
+    // Fill buffers right away instead of on next frame
+    update();
+}
+
+auto Stream::stop() noexcept -> void {
+    ::StopAudioStream(_audio);
+    rewind();
+}
+
+auto Stream::seek(float cursor) noexcept -> void {
+    if (const auto code = ov_time_seek(_vorbis.get(), double(cursor)); code != 0) {
+        SPDLOG_WARN("Could not seek music stream to {}s (error {})", cursor, code);
+        return;
+    }
+    _ended = false;
+    _drained = false;
+}
+
+Stream::~Stream() noexcept {
+    // Safe on never opened or failed to open file
+    ov_clear(_vorbis.get());
+}
+
+Stream::Stream(std::unique_ptr<IFileReader> file) :
+    _reader(std::move(file)),
+    _vorbis(std::make_unique<OggVorbis_File>()) {}
+
+auto Stream::decode() noexcept -> size_t {
+    constexpr auto BIG_ENDIAN_SAMPLES = std::endian::native == std::endian::big ? 1 : 0;
+    constexpr auto WORD_SIZE = int {sizeof(int16_t)};
+
+    const auto bytes = std::as_writable_bytes(std::span(_pcm));
+    auto filled = size_t {};
+    auto rewound = false;
+    while (filled < bytes.size()) {
+        auto section = int {};
+        // NOLINTNEXTLINE: ov_read writes interleaved samples as raw bytes
+        const auto buf = reinterpret_cast<char *>(bytes.data() + filled);
+        const auto n = ov_read(_vorbis.get(), buf, int(bytes.size() - filled), BIG_ENDIAN_SAMPLES, WORD_SIZE, 1, &section);
+        // Interruption in data, decoding continues after it
+        if (n == OV_HOLE) continue;
+        if (n < 0) {
+            SPDLOG_WARN("Could not decode music stream (error {})", n);
+            break;
+        }
+        if (n == 0) {
+            // Rewinding empty stream would never end
+            if (!looping || rewound) break;
+            if (ov_pcm_seek(_vorbis.get(), 0) != 0) break;
+            rewound = true;
+            continue;
+        }
+        rewound = false;
+        filled += size_t(n);
+    }
+
+    return filled / sizeof(int16_t) / size_t(_audio.channels);
+}
+
+auto Stream::rewind() noexcept -> void {
+    if (const auto code = ov_pcm_seek(_vorbis.get(), 0); code != 0) {
+        SPDLOG_WARN("Could not rewind music stream (error {})", code);
+    }
+    _ended = false;
+    _drained = false;
+}
+
+} // namespace glint::engine::audio::music
@@ -2,16 +2,22 @@
 
 #include <algorithm>
 
+#include <fmt/format.h>
+
 namespace glint::engine::audio::sound {
 
-auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Sound> {
-    auto data = store.read_bytes(name);
+/// Compressed data is released before returning, so it never lives alongside uploaded sound
+auto decode(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<rl::Wave> {
+    const auto data = store.map(name);
     if (!data) return err(data);
-    auto buf = std::make_unique<unsigned char[]>(data->size());
-    std::ranges::copy(*data, buf.get());
-    auto span = std::span {buf.get(), data->size()};
-    auto wave = rl::Wave::load_from_memory(name.extension().string().c_str(), span);
-    auto raylib_sound = rl::Sound::load_from_wave(wave);
+    auto wave = rl::Wave::load_from_memory(name.extension().string().c_str(), data->bytes());
+    if (!::IsWaveValid(wave)) return err(fmt::format("Could not decode sound {}", name.string()));
+    return wave;
+}
+
+auto from_wave(const rl::Wave& wave) noexcept -> Sound {
+    // Without audio device (headless run) sound stays empty, raylib ignores calls on it
+    auto raylib_sound = ::IsAudioDeviceReady() ? rl::Sound::load_from_wave(wave) : rl::Sound {};
 
     auto sound = Sound {.sound = std::move(raylib_sound)};
     ::SetSoundVolume(sound.sound, sound.volume);
@@ -21,6 +27,12 @@ auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Resu
     return sound;
 }
 
+auto load(const std::filesystem::path& name, IFileStore& store) noexcept -> Result<Sound> {
+    auto wave = decode(name, store);
+    if (!wave) return err(wave);
+    return from_wave(*wave);
+}
+
 auto unload(owner<Sound *> self) noexcept -> void {
     if (self == nullptr) {
         return;
@@ -1,17 +1,148 @@
 #include <file_store.hpp>
 
+#include <cstring>
 #include <fstream>
-#include <iterator>
-#include <sstream>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <zip.h>
 #include <spdlog/spdlog.h>
 
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 #include <defer.hpp>
 
 namespace glint {
 
+#ifdef _WIN32
+
+auto MappedBuffer::map_file(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> try {
+    SPDLOG_TRACE("Mapping file `{}`", path.string());
+    const auto file = ::CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return err(fmt::format("Could not open {}: error {}", path.string(), ::GetLastError()));
+    }
+    defer(::CloseHandle(file));
+
+    auto size = LARGE_INTEGER {};
+    if (!::GetFileSizeEx(file, &size)) {
+        return err(fmt::format("Could not get size of {}: error {}", path.string(), ::GetLastError()));
+    }
+    // Empty files can not be mapped
+    if (size.QuadPart == 0) return MappedBuffer {};
+
+    const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) return err(fmt::format("Could not map {}: error {}", path.string(), ::GetLastError()));
+    // View keeps mapping object alive
+    defer(::CloseHandle(mapping));
+
+    const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) return err(fmt::format("Could not map {}: error {}", path.string(), ::GetLastError()));
+
+    auto buffer = MappedBuffer {};
+    buffer._mapping = view;
+    buffer._data = static_cast<const unsigned char *>(view);
+    buffer._size = size_t(size.QuadPart);
+    return buffer;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto MappedBuffer::reset() noexcept -> void {
+    if (_mapping != nullptr) ::UnmapViewOfFile(_mapping);
+    _mapping = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _owned = {};
+}
+
+#else
+
+auto MappedBuffer::map_file(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> try {
+    SPDLOG_TRACE("Mapping file `{}`", path.string());
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return err(fmt::format("Could not open {}: {}", path.string(), strerror(errno)));
+    // Mapping stays valid after descriptor is closed
+    defer(::close(fd));
+
+    struct stat st {};
+    if (::fstat(fd, &st) < 0) return err(fmt::format("Could not stat {}: {}", path.string(), strerror(errno)));
+    // Empty files can not be mapped
+    if (st.st_size == 0) return MappedBuffer {};
+
+    const auto size = size_t(st.st_size);
+    const auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) return err(fmt::format("Could not map {}: {}", path.string(), strerror(errno)));
+    // Decoders mostly read front to back
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+
+    auto buffer = MappedBuffer {};
+    buffer._mapping = addr;
+    buffer._data = static_cast<const unsigned char *>(addr);
+    buffer._size = size;
+    return buffer;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto MappedBuffer::reset() noexcept -> void {
+    if (_mapping != nullptr) ::munmap(_mapping, _size);
+    _mapping = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _owned = {};
+}
+
+#endif
+
+auto MappedBuffer::from_bytes(std::vector<char>&& bytes) noexcept -> MappedBuffer {
+    auto buffer = MappedBuffer {};
+    buffer._owned = std::move(bytes);
+    // NOLINTNEXTLINE: cast from char* to unsigned char* is safe
+    buffer._data = reinterpret_cast<const unsigned char *>(buffer._owned.data());
+    buffer._size = buffer._owned.size();
+    return buffer;
+}
+
+MappedBuffer::MappedBuffer(MappedBuffer&& other) noexcept :
+    _data(std::exchange(other._data, nullptr)),
+    _size(std::exchange(other._size, 0)),
+    _mapping(std::exchange(other._mapping, nullptr)),
+    _owned(std::move(other._owned)) {}
+
+auto MappedBuffer::operator=(MappedBuffer&& other) noexcept -> MappedBuffer& {
+    if (this == &other) return *this;
+    reset();
+    _data = std::exchange(other._data, nullptr);
+    _size = std::exchange(other._size, 0);
+    _mapping = std::exchange(other._mapping, nullptr);
+    _owned = std::move(other._owned);
+    return *this;
+}
+
+MappedBuffer::~MappedBuffer() noexcept {
+    reset();
+}
+
 auto FilesystemStore::open(std::filesystem::path base_path) noexcept -> Result<FilesystemStore> {
     auto store = FilesystemStore {std::move(base_path)};
     return store;
@@ -28,14 +159,25 @@ auto FilesystemStore::read(const std::filesystem::path& file_path, std::ostream&
     return err(e);
 }
 
+/// Read whole file with single read into storage of known size
+template<typename T>
+static auto read_whole_file(const std::filesystem::path& path) -> Result<T> {
+    auto file = std::ifstream {path, std::ios::in | std::ios::binary | std::ios::ate};
+    if (!file) return err(fmt::format("Could not open {}: {}", path.string(), strerror(errno)));
+    const auto size = file.tellg();
+    if (size < 0) return err(fmt::format("Could not get size of {}", path.string()));
+    file.seekg(0);
+
+    auto buf = T(size_t(size), '\0');
+    file.read(buf.data(), size);
+    if (!file) return err(fmt::format("Could not read {}: {}", path.string(), strerror(errno)));
+    return buf;
+}
+
 auto FilesystemStore::read_bytes(const std::filesystem::path& file_path) noexcept -> Result<std::vector<char>> try {
     const auto path = _base_path / file_path;
     SPDLOG_TRACE("Reading file `{}` to vector", path.string());
-    auto file = std::ifstream {path, std::ios::in | std::ios::binary};
-    auto eos = std::istreambuf_iterator<char>();
-    auto buf = std::vector<char>(std::istreambuf_iterator<char>(file), eos);
-    if (!file) return err(fmt::format("Could not read: {}", strerror(errno)));
-    return buf;
+    return read_whole_file<std::vector<char>>(path);
 } catch (std::exception& e) {
     return err(e);
 }
@@ -43,20 +185,157 @@ auto FilesystemStore::read_bytes(const std::filesystem::path& file_path) noexcep
 auto FilesystemStore::read_string(const std::filesystem::path& file_path) noexcept -> Result<std::string> try {
     const auto path = _base_path / file_path;
     SPDLOG_TRACE("Reading file `{}` to string", path.string());
-    auto file = std::ifstream {path, std::ios::in | std::ios::binary};
-    auto buf = std::stringstream {};
-    buf << file.rdbuf();
-    if (!file) return err(fmt::format("Could not read: {}", strerror(errno)));
-    return buf.str();
+    return read_whole_file<std::string>(path);
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto FilesystemStore::map(const std::filesystem::path& file_path) noexcept -> Result<MappedBuffer> {
+    return MappedBuffer::map_file(_base_path / file_path);
+}
+
+auto FilesystemStore::exists(const std::filesystem::path& file_path) noexcept -> bool {
+    auto ec = std::error_code {};
+    return std::filesystem::is_regular_file(_base_path / file_path, ec);
+}
+
+class FilesystemReader final: public IFileReader {
+  private:
+    std::ifstream _file;
+    uint64_t _size;
+    uint64_t _position = 0;
+
+  public:
+    FilesystemReader(std::ifstream&& file, uint64_t size) noexcept : _file(std::move(file)), _size(size) {}
+
+    auto read(std::span<char> buf) noexcept -> Result<size_t> override try {
+        _file.read(buf.data(), std::streamsize(buf.size()));
+        if (_file.bad()) return err(fmt::format("Could not read: {}", strerror(errno)));
+        const auto n = size_t(_file.gcount());
+        // Short read at end of file sets failbit, which would break following seeks
+        _file.clear();
+        _position += n;
+        return n;
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    auto seek(uint64_t offset) noexcept -> Result<> override try {
+        if (offset > _size) return err(fmt::format("Offset {} is past end of file of size {}", offset, _size));
+        _file.seekg(std::streamoff(offset));
+        if (!_file) return err(fmt::format("Could not seek: {}", strerror(errno)));
+        _position = offset;
+        return {};
+    } catch (std::exception& e) {
+        return err(e);
+    }
+
+    auto tell() const noexcept -> uint64_t override {
+        return _position;
+    }
+
+    auto size() const noexcept -> uint64_t override {
+        return _size;
+    }
+};
+
+auto FilesystemStore::open_file(const std::filesystem::path& file_path) noexcept
+    -> Result<std::unique_ptr<IFileReader>> try {
+    const auto path = _base_path / file_path;
+    SPDLOG_TRACE("Opening file `{}` for reading", path.string());
+    auto file = std::ifstream {path, std::ios::in | std::ios::binary | std::ios::ate};
+    if (!file) return err(fmt::format("Could not open {}: {}", path.string(), strerror(errno)));
+    const auto size = file.tellg();
+    if (size < 0) return err(fmt::format("Could not get size of {}", path.string()));
+    file.seekg(0);
+    return std::make_unique<FilesystemReader>(std::move(file), uint64_t(size));
 } catch (std::exception& e) {
     return err(e);
 }
 
 FilesystemStore::FilesystemStore(std::filesystem::path&& base_path) noexcept : _base_path(std::move(base_path)) {}
 
+/// Open archive handles of one archive, idle ones are kept for next reads
+struct ZipHandlePool {
+    std::filesystem::path path {};
+    std::mutex mutex {};
+    std::vector<zip_t *> idle {};
+
+    ZipHandlePool(std::filesystem::path p) noexcept : path(std::move(p)) {}
+    ZipHandlePool(const ZipHandlePool&) = delete;
+    ZipHandlePool(ZipHandlePool&&) = delete;
+    auto operator=(const ZipHandlePool&) -> ZipHandlePool& = delete;
+    auto operator=(ZipHandlePool&&) -> ZipHandlePool& = delete;
+
+    ~ZipHandlePool() {
+        // Archive is read-only, nothing to write back
+        for (const auto zip : idle) zip_discard(zip);
+    }
+};
+
+static auto open_archive(const std::filesystem::path& path) -> Result<zip_t *> {
+    auto ec = int {};
+    auto zip = zip_open(path.string().c_str(), ZIP_RDONLY, &ec);
+    if (zip == nullptr) {
+        auto e = zip_error_t {};
+        zip_error_init_with_code(&e, ec);
+        defer(zip_error_fini(&e));
+        return err(fmt::format("Could not open archive `{}`: {}", path.string(), zip_error_strerror(&e)));
+    }
+    return zip;
+}
+
+/// Archive handle used by one reader at a time, returned to pool when lease ends
+class ZipLease {
+  private:
+    std::shared_ptr<ZipHandlePool> _pool;
+    zip_t *_zip;
+
+  public:
+    static auto take(const std::shared_ptr<ZipHandlePool>& pool) -> Result<ZipLease> {
+        {
+            auto lock = std::lock_guard {pool->mutex};
+            if (!pool->idle.empty()) {
+                const auto zip = pool->idle.back();
+                pool->idle.pop_back();
+                return ZipLease {pool, zip};
+            }
+        }
+        // Opening reads central directory, which is done outside of lock too
+        auto zip = open_archive(pool->path);
+        if (!zip) return err(zip);
+        return ZipLease {pool, *zip};
+    }
+
+    ZipLease(const ZipLease&) = delete;
+    ZipLease(ZipLease&& other) noexcept : _pool(std::move(other._pool)), _zip(std::exchange(other._zip, nullptr)) {}
+    auto operator=(const ZipLease&) -> ZipLease& = delete;
+    auto operator=(ZipLease&&) -> ZipLease& = delete;
+
+    ~ZipLease() {
+        if (_zip == nullptr) return;
+        try {
+            auto lock = std::lock_guard {_pool->mutex};
+            _pool->idle.push_back(_zip);
+        } catch (...) {
+            zip_discard(_zip);
+        }
+    }
+
+    [[nodiscard]]
+    auto get() const noexcept -> zip_t * {
+        return _zip;
+    }
+
+  private:
+    ZipLease(std::shared_ptr<ZipHandlePool> pool, zip_t *zip) noexcept : _pool(std::move(pool)), _zip(zip) {}
+};
+
 auto ZipStore::read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> try {
-    auto file = zip_fopen(_zip, path.string().c_str(), 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
+    const auto zip = ZipLease::take(_pool);
+    if (!zip) return err(zip);
+    auto file = zip_fopen(zip->get(), path.string().c_str(), 0);
+    if (file == nullptr) return err(zip_strerror(zip->get()));
     defer(zip_fclose(file));
 
     auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
@@ -74,82 +353,139 @@ auto ZipStore::read(const std::filesystem::path& path, std::ostream& stream) noe
     return err(e);
 }
 
-auto ZipStore::read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> try {
+/// Decompress entry straight into storage of entry size, without intermediate buffers
+template<typename T>
+static auto read_entry(zip_t *zip, const std::filesystem::path& path) -> Result<T> {
     auto stats = zip_stat_t {};
-    if (zip_stat(_zip, path.string().c_str(), 0, &stats) < 0) return err(zip_strerror(_zip));
+    if (zip_stat(zip, path.generic_string().c_str(), 0, &stats) < 0) return err(zip_strerror(zip));
 
-    auto file = zip_fopen(_zip, stats.name, 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
+    auto file = zip_fopen_index(zip, stats.index, 0);
+    if (file == nullptr) return err(zip_strerror(zip));
     defer(zip_fclose(file));
 
-    auto vec = std::vector<char> {};
-    vec.reserve(stats.size);
-    auto iter = std::back_inserter(vec);
-
-    auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
-    for (;;) {
-        auto n = zip_fread(file, buf->data(), buf->size());
+    auto buf = T(size_t(stats.size), '\0');
+    auto offset = size_t {};
+    while (offset < buf.size()) {
+        auto n = zip_fread(file, buf.data() + offset, buf.size() - offset);
         if (n < 0) return err(zip_file_strerror(file));
-        if (n == 0) break;
-
-        std::copy(buf->begin(), buf->begin() + n, iter);
+        if (n == 0) return err(fmt::format("Unexpected end of entry {}", path.string()));
+        offset += size_t(n);
     }
 
-    return vec;
+    return buf;
+}
+
+auto ZipStore::read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> try {
+    SPDLOG_TRACE("Reading entry `{}` to vector", path.string());
+    const auto zip = ZipLease::take(_pool);
+    if (!zip) return err(zip);
+    return read_entry<std::vector<char>>(zip->get(), path);
 } catch (std::exception& e) {
     return err(e);
 }
 
 auto ZipStore::read_string(const std::filesystem::path& path) noexcept -> Result<std::string> try {
-    auto file = zip_fopen(_zip, path.string().c_str(), 0);
-    if (file == nullptr) return err(zip_strerror(_zip));
-    defer(zip_fclose(file));
+    SPDLOG_TRACE("Reading entry `{}` to string", path.string());
+    const auto zip = ZipLease::take(_pool);
+    if (!zip) return err(zip);
+    return read_entry<std::string>(zip->get(), path);
+} catch (std::exception& e) {
+    return err(e);
+}
 
-    auto str = std::string {};
-    auto buf = std::make_unique<std::array<char, 512ul * 1024ul>>();
-    for (;;) {
-        auto n = zip_fread(file, buf->data(), buf->size());
-        if (n < 0) return err(zip_file_strerror(file));
-        if (n == 0) break;
+auto ZipStore::map(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> {
+    // Entries may be compressed, so they are read into memory instead of mapped. Bytes are read once and ownership
+    // is handed over to buffer
+    auto bytes = read_bytes(path);
+    if (!bytes) return err(bytes);
+    return MappedBuffer::from_bytes(std::move(*bytes));
+}
+
+/// Keeps its archive handle until closed, so streaming never waits for other reads
+class ZipReader final: public IFileReader {
+  private:
+    ZipLease _zip;
+    zip_file_t *_file;
+    uint64_t _size;
+    uint64_t _position = 0;
+
+  public:
+    ZipReader(ZipLease&& zip, zip_file_t *file, uint64_t size) noexcept :
+        _zip(std::move(zip)),
+        _file(file),
+        _size(size) {}
 
-        str.append(buf->begin(), buf->begin() + n);
+    ~ZipReader() override {
+        zip_fclose(_file);
     }
 
-    return str;
-} catch (std::exception& e) {
-    return err(e);
-}
+    ZipReader(const ZipReader&) = delete;
+    ZipReader(ZipReader&&) = delete;
+    auto operator=(const ZipReader&) -> ZipReader& = delete;
+    auto operator=(ZipReader&&) -> ZipReader& = delete;
 
-// TODO: Open from self
-auto ZipStore::open(const std::filesystem::path& path) noexcept -> Result<ZipStore> {
-    auto ec = int {};
-    auto zip = zip_open(path.string().c_str(), ZIP_RDONLY, &ec);
-    if (zip == nullptr) {
-        auto e = zip_error_t {};
-        zip_error_init_with_code(&e, ec);
-        defer(zip_error_fini(&e));
-        return err(fmt::format("Could not open archive `{}`: {}", path.string(), zip_error_strerror(&e)));
+    auto read(std::span<char> buf) noexcept -> Result<size_t> override {
+        const auto n = zip_fread(_file, buf.data(), buf.size());
+        if (n < 0) return err(zip_file_strerror(_file));
+        _position += uint64_t(n);
+        return size_t(n);
     }
-    return ZipStore(zip);
-}
 
-ZipStore::ZipStore(ZipStore&& other) noexcept : _zip(other._zip) {
-    other._zip = nullptr;
+    auto seek(uint64_t offset) noexcept -> Result<> override {
+        if (offset > _size) return err(fmt::format("Offset {} is past end of entry of size {}", offset, _size));
+        if (zip_fseek(_file, zip_int64_t(offset), SEEK_SET) < 0) return err(zip_file_strerror(_file));
+        _position = offset;
+        return {};
+    }
+
+    auto tell() const noexcept -> uint64_t override {
+        return _position;
+    }
+
+    auto size() const noexcept -> uint64_t override {
+        return _size;
+    }
 };
 
-auto ZipStore::operator=(ZipStore&& other) noexcept -> ZipStore& {
-    // TODO: Free this->_zip?
-    auto zip = other._zip;
-    other._zip = nullptr;
-    _zip = zip;
-    return *this;
+auto ZipStore::open_file(const std::filesystem::path& path) noexcept -> Result<std::unique_ptr<IFileReader>> try {
+    SPDLOG_TRACE("Opening entry `{}` for reading", path.string());
+    auto zip = ZipLease::take(_pool);
+    if (!zip) return err(zip);
+    auto stats = zip_stat_t {};
+    if (zip_stat(zip->get(), path.generic_string().c_str(), 0, &stats) < 0) return err(zip_strerror(zip->get()));
+
+    // Only stored entries can seek without inflating everything before target offset
+    const auto stored = (stats.valid & ZIP_STAT_COMP_METHOD) != 0 && stats.comp_method == ZIP_CM_STORE;
+    const auto plain = (stats.valid & ZIP_STAT_ENCRYPTION_METHOD) == 0 || stats.encryption_method == ZIP_EM_NONE;
+    if (!stored || !plain) {
+        return err(fmt::format("Entry {} is compressed and can not be read in chunks", path.string()));
+    }
+
+    auto file = zip_fopen_index(zip->get(), stats.index, 0);
+    if (file == nullptr) return err(zip_strerror(zip->get()));
+    return std::make_unique<ZipReader>(std::move(*zip), file, uint64_t(stats.size));
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto ZipStore::exists(const std::filesystem::path& path) noexcept -> bool try {
+    const auto zip = ZipLease::take(_pool);
+    return zip && zip_name_locate(zip->get(), path.generic_string().c_str(), 0) >= 0;
+} catch (...) {
+    return false;
 }
 
-ZipStore::~ZipStore() {
-    if (_zip == nullptr) return;
-    zip_close(_zip);
+// TODO: Open from self
+auto ZipStore::open(const std::filesystem::path& path) noexcept -> Result<ZipStore> try {
+    auto pool = std::make_shared<ZipHandlePool>(path);
+    // Archive is opened once here, so that broken archive is reported before game starts
+    auto zip = ZipLease::take(pool);
+    if (!zip) return err(zip);
+    return ZipStore(std::move(pool));
+} catch (std::exception& e) {
+    return err(e);
 }
 
-ZipStore::ZipStore(zip_t *zip) : _zip(zip) {};
+ZipStore::ZipStore(std::shared_ptr<ZipHandlePool> pool) noexcept : _pool(std::move(pool)) {}
 
 } // namespace glint
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <ostream>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -11,6 +15,81 @@ using zip_t = struct zip;
 
 namespace glint {
 
+/// Read-only file contents. Backed by memory mapping when store supports it, otherwise owns the bytes read.
+/// Pages of mapped file are loaded lazily by OS and are shared with page cache, so no copy is made.
+class MappedBuffer {
+  private:
+    const unsigned char *_data = nullptr;
+    size_t _size = 0;
+    void *_mapping = nullptr;
+    std::vector<char> _owned {};
+
+  public:
+    /// Map entire file into memory
+    static auto map_file(const std::filesystem::path& path) noexcept -> Result<MappedBuffer>;
+
+    /// Take ownership of bytes that were already read
+    static auto from_bytes(std::vector<char>&& bytes) noexcept -> MappedBuffer;
+
+    MappedBuffer() noexcept = default;
+    MappedBuffer(const MappedBuffer&) = delete;
+    MappedBuffer(MappedBuffer&& other) noexcept;
+    auto operator=(const MappedBuffer&) -> MappedBuffer& = delete;
+    auto operator=(MappedBuffer&& other) noexcept -> MappedBuffer&;
+    ~MappedBuffer() noexcept;
+
+    [[nodiscard]]
+    auto bytes() const noexcept -> std::span<const unsigned char> {
+        return {_data, _size};
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> size_t {
+        return _size;
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool {
+        return _size == 0;
+    }
+
+    /// Whether contents are mapped from file rather than owned
+    [[nodiscard]]
+    auto is_mapped() const noexcept -> bool {
+        return _mapping != nullptr;
+    }
+
+  private:
+    auto reset() noexcept -> void;
+};
+
+/// File opened for reading in chunks with seeking, without loading it into memory
+class IFileReader {
+  public:
+    /// Read up to `buf.size()` bytes, returns number of bytes read or 0 at end of file
+    virtual auto read(std::span<char> buf) noexcept -> Result<size_t> = 0;
+
+    /// Move to absolute offset from file start
+    virtual auto seek(uint64_t offset) noexcept -> Result<> = 0;
+
+    /// Current offset from file start
+    [[nodiscard]]
+    virtual auto tell() const noexcept -> uint64_t = 0;
+
+    /// Total file size
+    [[nodiscard]]
+    virtual auto size() const noexcept -> uint64_t = 0;
+
+    virtual ~IFileReader() = default;
+    IFileReader(const IFileReader&) = delete;
+    IFileReader(IFileReader&&) = delete;
+    auto operator=(const IFileReader&) -> IFileReader& = delete;
+    auto operator=(IFileReader&&) -> IFileReader& = delete;
+
+  protected:
+    IFileReader() = default;
+};
+
 class IFileStore {
   public:
     /// Read file to stream
@@ -22,6 +101,15 @@ class IFileStore {
     /// Read entire file and return bytes
     virtual auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> = 0;
 
+    /// Get read-only view of entire file, mapping it into memory when possible
+    virtual auto map(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> = 0;
+
+    /// Open file for seekable reads in chunks. Fails if store can not seek in file
+    virtual auto open_file(const std::filesystem::path& path) noexcept -> Result<std::unique_ptr<IFileReader>> = 0;
+
+    /// Check if file exists in store
+    virtual auto exists(const std::filesystem::path& path) noexcept -> bool = 0;
+
     virtual ~IFileStore() = default;
     IFileStore(const IFileStore&) = default;
     IFileStore(IFileStore&&) = default;
@@ -42,14 +130,22 @@ class FilesystemStore final: public IFileStore {
     auto read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> override;
     auto read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> override;
     auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> override;
+    auto map(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> override;
+    auto open_file(const std::filesystem::path& path) noexcept -> Result<std::unique_ptr<IFileReader>> override;
+    auto exists(const std::filesystem::path& path) noexcept -> bool override;
 
   private:
     FilesystemStore(std::filesystem::path&& base_path) noexcept;
 };
 
+struct ZipHandlePool;
+
+/// libzip archive handle is not thread-safe, so every read takes a handle of its own from pool, opening archive
+/// again when all are taken. Lock is held only while taking or returning handle, so long reads on workers never
+/// block streaming reads on main thread
 class ZipStore final: public IFileStore {
   private:
-    zip_t *_zip;
+    std::shared_ptr<ZipHandlePool> _pool;
 
   public:
     static auto open(const std::filesystem::path& path) noexcept -> Result<ZipStore>;
@@ -57,15 +153,12 @@ class ZipStore final: public IFileStore {
     auto read(const std::filesystem::path& path, std::ostream& stream) noexcept -> Result<> override;
     auto read_bytes(const std::filesystem::path& path) noexcept -> Result<std::vector<char>> override;
     auto read_string(const std::filesystem::path& path) noexcept -> Result<std::string> override;
-
-    ZipStore(const ZipStore&) = delete;
-    ZipStore(ZipStore&& other) noexcept;
-    auto operator=(const ZipStore&) -> ZipStore& = delete;
-    auto operator=(ZipStore&& other) noexcept -> ZipStore&;
-    ~ZipStore() override;
+    auto map(const std::filesystem::path& path) noexcept -> Result<MappedBuffer> override;
+    auto open_file(const std::filesystem::path& path) noexcept -> Result<std::unique_ptr<IFileReader>> override;
+    auto exists(const std::filesystem::path& path) noexcept -> bool override;
 
   private:
-    ZipStore(zip_t *zip);
+    ZipStore(std::shared_ptr<ZipHandlePool> pool) noexcept;
 };
 
 } // namespace glint
@@ -0,0 +1,275 @@
+#include <glyph_cache.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <fmt/format.h>
+#include <rlgl.h>
+#include <spdlog/spdlog.h>
+
+#include <defer.hpp>
+
+namespace glint {
+
+/// Same as rtext.c FONT_TTF_DEFAULT_CHARS_PADDING, used by fonts baked at load time
+static constexpr auto GLYPH_PADDING = 4;
+static constexpr auto GRAY_ALPHA_SIZE = size_t {2};
+static constexpr auto PAGE_BYTES = size_t(GLYPH_PAGE_SIZE) * size_t(GLYPH_PAGE_SIZE) * GRAY_ALPHA_SIZE;
+
+/// Caches by address of font they maintain. Fonts reach draw calls as plain raylib fonts
+static auto registry() -> std::unordered_map<const ::Font *, GlyphCache *>& {
+    static auto caches = std::unordered_map<const ::Font *, GlyphCache *> {};
+    return caches;
+}
+
+/// Font without glyphs, arrays and texture are filled by cache
+static auto empty_font(int font_size) noexcept -> rl::Font {
+    auto font = ::Font {};
+    font.baseSize = font_size;
+    font.glyphPadding = GLYPH_PADDING;
+    return rl::Font::adopt(font);
+}
+
+GlyphCache::GlyphCache(MappedBuffer data, int font_size) noexcept :
+    _data {std::move(data)},
+    _font {empty_font(font_size)} {}
+
+GlyphCache::~GlyphCache() noexcept {
+    registry().erase(&_font);
+}
+
+auto GlyphCache::create(MappedBuffer data, int font_size) noexcept -> Result<std::unique_ptr<GlyphCache>> try {
+    if (font_size <= 0 || font_size + 2 * GLYPH_PADDING > GLYPH_PAGE_SIZE) {
+        return err(fmt::format("Font size {} does not fit into glyph page", font_size));
+    }
+
+    auto cache = std::unique_ptr<GlyphCache>(new GlyphCache(std::move(data), font_size));
+    if (!cache->grow()) return err("Could not allocate glyph page");
+    // Font data is only parsed when glyphs are rasterized, so it is checked with fallback glyph right away
+    cache->require(std::array {int {'?'}});
+    if (cache->_font.glyphCount == 0) return err("Could not rasterize glyphs of font");
+
+    registry().insert_or_assign(&cache->_font, cache.get());
+    return cache;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+auto GlyphCache::find(const ::Font& font) noexcept -> GlyphCache * {
+    const auto& caches = registry();
+    const auto it = caches.find(&font);
+    return it == caches.end() ? nullptr : it->second;
+}
+
+auto GlyphCache::require(const std::string& text) noexcept -> void try {
+    _scratch.clear();
+    for (size_t i = 0; i < text.size();) {
+        auto size = 0;
+        _scratch.push_back(::GetCodepointNext(text.c_str() + i, &size));
+        i += size_t(std::max(size, 1));
+    }
+    require_scratch();
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not cache glyphs: {}", e.what());
+}
+
+auto GlyphCache::require(std::span<const int> codepoints) noexcept -> void try {
+    _scratch.assign(codepoints.begin(), codepoints.end());
+    require_scratch();
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not cache glyphs: {}", e.what());
+}
+
+auto GlyphCache::size_bytes() const noexcept -> size_t {
+    // Pages are kept both in CPU memory and in texture
+    const auto arrays = size_t(_capacity) * (sizeof(::GlyphInfo) + sizeof(::Rectangle));
+    return _data.size() + _pixels.size() * 2 + arrays;
+}
+
+/// Touch pages of cached codepoints in `_scratch` and rasterize the rest
+auto GlyphCache::require_scratch() -> void {
+    const auto tick = ++_tick;
+    auto missing = size_t {};
+    for (size_t i = 0; i < _scratch.size(); i++) {
+        if (auto it = _index.find(_scratch[i]); it != _index.end()) {
+            _page_use[_glyph_page[size_t(it->second)]] = tick;
+        } else {
+            _scratch[missing++] = _scratch[i];
+        }
+    }
+    if (missing == 0) return;
+
+    _scratch.resize(missing);
+    std::ranges::sort(_scratch);
+    _scratch.erase(std::ranges::unique(_scratch).begin(), _scratch.end());
+
+    const auto count = int(_scratch.size());
+    if (!reserve(_font.glyphCount + count)) {
+        SPDLOG_WARN("Could not grow glyph arrays of font size {}", _font.baseSize);
+        return;
+    }
+
+    const auto bytes = _data.bytes();
+    auto glyphs = ::LoadFontData(bytes.data(), int(bytes.size()), _font.baseSize, _scratch.data(), count, FONT_DEFAULT);
+    if (glyphs == nullptr) {
+        SPDLOG_WARN("Could not rasterize {} glyphs of font size {}", count, _font.baseSize);
+        return;
+    }
+    defer(::UnloadFontData(glyphs, count));
+
+    SPDLOG_DEBUG("Rasterizing {} glyphs of font size {}", count, _font.baseSize);
+    for (const auto& glyph : std::span(glyphs, size_t(count))) insert(glyph, tick);
+}
+
+/// Pack glyph into first page it fits, growing texture or evicting least recently used page when none has room
+auto GlyphCache::insert(const ::GlyphInfo& glyph, uint64_t tick) -> void {
+    const auto padding = _font.glyphPadding;
+    const auto& image = glyph.image;
+    const auto width = image.width + 2 * padding;
+    const auto height = image.height + 2 * padding;
+
+    auto page = size_t {};
+    auto rect = std::optional<PackRect> {};
+    const auto place = [&](size_t p) -> bool {
+        rect = _packers[p].insert(width, height);
+        if (rect) page = p;
+        return rect.has_value();
+    };
+
+    auto placed = false;
+    for (size_t p = 0; p < _packers.size() && !placed; p++) placed = place(p);
+    if (!placed && grow()) placed = place(_packers.size() - 1);
+    if (!placed) {
+        // Pages used by current `require` hold glyphs of text about to be drawn
+        auto lru = std::optional<size_t> {};
+        for (size_t p = 0; p < _page_use.size(); p++) {
+            if (_page_use[p] != tick && (!lru || _page_use[p] < _page_use[*lru])) lru = p;
+        }
+        if (lru) {
+            evict(*lru);
+            placed = place(*lru);
+        }
+    }
+    if (!placed) {
+        SPDLOG_WARN("Glyph {} does not fit into glyph cache of font size {}", glyph.value, _font.baseSize);
+        return;
+    }
+
+    // Same texel layout as GenImageFontAtlas: white with coverage in alpha, padding is transparent
+    auto block = std::vector<unsigned char>(size_t(width) * size_t(height) * GRAY_ALPHA_SIZE);
+    for (size_t i = 0; i < block.size(); i += GRAY_ALPHA_SIZE) block[i] = 255;
+    if (const auto src = static_cast<const unsigned char *>(image.data)) {
+        for (auto y = 0; y < image.height; y++) {
+            for (auto x = 0; x < image.width; x++) {
+                const auto offset = (size_t(y + padding) * size_t(width) + size_t(x + padding)) * GRAY_ALPHA_SIZE;
+                block[offset + 1] = src[size_t(y) * size_t(image.width) + size_t(x)];
+            }
+        }
+    }
+
+    const auto top = int(page) * GLYPH_PAGE_SIZE + rect->y;
+    const auto row = size_t(width) * GRAY_ALPHA_SIZE;
+    for (auto y = 0; y < height; y++) {
+        const auto offset = (size_t(top + y) * size_t(GLYPH_PAGE_SIZE) + size_t(rect->x)) * GRAY_ALPHA_SIZE;
+        std::copy_n(block.begin() + std::ptrdiff_t(size_t(y) * row), row, _pixels.begin() + std::ptrdiff_t(offset));
+    }
+    if (_font.texture.id != 0) {
+        const auto area = Rectangle {float(rect->x), float(top), float(width), float(height)};
+        ::UpdateTextureRec(_font.texture, area, block.data());
+    }
+
+    const auto index = _font.glyphCount++;
+    _font.glyphs[index] = glyph;
+    _font.glyphs[index].image = {};
+    _font.recs[index] = Rectangle {
+        .x = float(rect->x + padding),
+        .y = float(top + padding),
+        .width = float(image.width),
+        .height = float(image.height),
+    };
+    _index.insert_or_assign(glyph.value, index);
+    _glyph_page.push_back(page);
+    _page_use[page] = tick;
+}
+
+/// Make room for `count` glyphs in font arrays, which raylib frees with MemFree
+auto GlyphCache::reserve(int count) -> bool {
+    if (count <= _capacity) return true;
+    const auto capacity = std::max(count, _capacity * 2);
+
+    const auto glyphs = ::MemRealloc(_font.glyphs, unsigned(size_t(capacity) * sizeof(::GlyphInfo)));
+    if (glyphs == nullptr) return false;
+    _font.glyphs = static_cast<::GlyphInfo *>(glyphs);
+
+    const auto recs = ::MemRealloc(_font.recs, unsigned(size_t(capacity) * sizeof(::Rectangle)));
+    if (recs == nullptr) return false;
+    _font.recs = static_cast<::Rectangle *>(recs);
+
+    _capacity = capacity;
+    return true;
+}
+
+/// Add empty page below existing ones
+auto GlyphCache::grow() -> bool {
+    if (_packers.size() >= size_t(MAX_GLYPH_PAGES)) return false;
+
+    _pixels.reserve(_pixels.size() + PAGE_BYTES);
+    for (size_t i = 0; i < PAGE_BYTES; i += GRAY_ALPHA_SIZE) {
+        _pixels.push_back(255);
+        _pixels.push_back(0);
+    }
+    _packers.emplace_back(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    _page_use.push_back(0);
+    SPDLOG_DEBUG("Glyph cache of font size {} grew to {} pages", _font.baseSize, _packers.size());
+
+    upload();
+    return true;
+}
+
+/// Drop every glyph of page, so that page is packed again from scratch
+auto GlyphCache::evict(size_t page) -> void {
+    SPDLOG_DEBUG("Evicting glyph page {} of font size {}", page, _font.baseSize);
+    // Quads queued so far still sample glyphs of this page
+    if (_font.texture.id != 0) ::rlDrawRenderBatchActive();
+
+    auto i = 0;
+    while (i < _font.glyphCount) {
+        if (_glyph_page[size_t(i)] != page) {
+            i++;
+            continue;
+        }
+        const auto last = _font.glyphCount - 1;
+        _index.erase(_font.glyphs[i].value);
+        if (i != last) {
+            _font.glyphs[i] = _font.glyphs[last];
+            _font.recs[i] = _font.recs[last];
+            _glyph_page[size_t(i)] = _glyph_page[size_t(last)];
+            _index.insert_or_assign(_font.glyphs[i].value, i);
+        }
+        _glyph_page.pop_back();
+        _font.glyphCount--;
+    }
+
+    _packers[page] = MaxRectsPacker(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    _page_use[page] = 0;
+    _generation++;
+}
+
+/// Replace texture with one holding all pages. Font atlas is uploaded to GPU, which is not available without window
+auto GlyphCache::upload() -> void {
+    if (!::IsWindowReady()) return;
+    if (_font.texture.id != 0) {
+        // Quads queued so far refer to old texture
+        ::rlDrawRenderBatchActive();
+        ::UnloadTexture(_font.texture);
+    }
+    _font.texture = ::LoadTextureFromImage(::Image {
+        .data = _pixels.data(),
+        .width = GLYPH_PAGE_SIZE,
+        .height = GLYPH_PAGE_SIZE * int(_packers.size()),
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA,
+    });
+}
+
+} // namespace glint
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <atlas_packer.hpp>
+#include <error.hpp>
+#include <file_store.hpp>
+#include <raylib.hpp>
+
+namespace glint {
+
+/// Side of one glyph page. Pages are stacked vertically in font texture
+constexpr auto GLYPH_PAGE_SIZE = 1024;
+
+/// Pages font texture grows to. When all of them are full, least recently used page is emptied
+constexpr auto MAX_GLYPH_PAGES = 4;
+
+/// Glyphs of TTF/OTF font rasterized on demand, for fonts with codepoint sets too large to bake up front.
+/// Glyph is rasterized the first time it is required and packed into page of growable texture. Cache keeps arrays of
+/// its raylib Font up to date, so text is drawn by usual raylib functions right after `require`.
+/// Cache is only used from main thread
+class GlyphCache {
+  private:
+    MappedBuffer _data;
+    rl::Font _font;
+    /// Length of font arrays, which hold `glyphCount` glyphs
+    int _capacity = 0;
+    std::unordered_map<int, int> _index {};
+    /// Page of every glyph in font arrays
+    std::vector<size_t> _glyph_page {};
+    std::vector<MaxRectsPacker> _packers {};
+    /// Tick of last `require` that used each page
+    std::vector<uint64_t> _page_use {};
+    /// Gray-alpha copy of texture, so that it grows without reading pixels back from GPU
+    std::vector<unsigned char> _pixels {};
+    std::vector<int> _scratch {};
+    uint64_t _tick = 0;
+    uint64_t _generation = 0;
+
+  public:
+    /// Cache rasterizing glyphs of font file `data` at `font_size`. Texture is created only when window is ready
+    [[nodiscard]]
+    static auto create(MappedBuffer data, int font_size) noexcept -> Result<std::unique_ptr<GlyphCache>>;
+
+    /// Cache which maintains `font`, so that fonts given to raylib draw calls can be checked for it
+    [[nodiscard]]
+    static auto find(const ::Font& font) noexcept -> GlyphCache *;
+
+    GlyphCache(const GlyphCache&) = delete;
+    auto operator=(const GlyphCache&) -> GlyphCache& = delete;
+    ~GlyphCache() noexcept;
+
+    /// Rasterize missing glyphs of UTF-8 text and mark its pages as recently used. Pages used by this call are not
+    /// evicted by it, but may be by next one, so text has to be drawn before that
+    auto require(const std::string& text) noexcept -> void;
+
+    auto require(std::span<const int> codepoints) noexcept -> void;
+
+    [[nodiscard]]
+    auto font() noexcept -> rl::Font& {
+        return _font;
+    }
+
+    /// Changes whenever glyphs are evicted, so that glyph rectangles kept outside of font can be checked
+    [[nodiscard]]
+    auto generation() const noexcept -> uint64_t {
+        return _generation;
+    }
+
+    /// Font file, pages in CPU and GPU memory and glyph arrays
+    [[nodiscard]]
+    auto size_bytes() const noexcept -> size_t;
+
+  private:
+    GlyphCache(MappedBuffer data, int font_size) noexcept;
+
+    auto require_scratch() -> void;
+    auto insert(const ::GlyphInfo& glyph, uint64_t tick) -> void;
+    auto reserve(int count) -> bool;
+    auto grow() -> bool;
+    auto evict(size_t page) -> void;
+    auto upload() -> void;
+};
+
+} // namespace glint
@@ -1,18 +1,118 @@
+#include <charconv>
 #include <span>
 #include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 #include <spdlog/cfg/env.h>
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
 #include <defer.hpp>
 #include <engine.hpp>
 #include <plugins/audio.hpp>
 #include <plugins/console.hpp>
 #include <plugins/graphics.hpp>
 #include <plugins/math.hpp>
+#include <plugins/profiler.hpp>
+#include <plugins/timers.hpp>
 #include <plugins/window.hpp>
 #include <file_store.hpp>
+#include <pack.hpp>
+#include <profiler.hpp>
+
+static constexpr auto USAGE =
+    "Usage: {} [--headless] [--frames N] [--dt SECONDS] [--profile TRACE_FILE] [--trace-bindings] [GAME]";
+
+/// Plugins registered in engine. Packer creates them too, so that imports of their modules resolve
+static auto builtin_plugins(JSContext *js) -> std::vector<glint::plugins::EnginePlugin> {
+    using namespace glint;
+    return {
+        plugins::console::plugin(js),
+        plugins::math::plugin(js),
+        plugins::window::plugin(js),
+        plugins::graphics::plugin(js),
+        plugins::audio::plugin(js),
+        plugins::timers::plugin(js),
+        plugins::profiler::plugin(js),
+    };
+}
+
+static constexpr auto PACK_USAGE = "Usage: {} pack GAME_DIR [-o OUTPUT] [--compress]";
+
+/// `glint pack` subcommand
+static auto pack(std::span<char *> args) noexcept -> int try {
+    using namespace glint;
+
+    auto game_dir = std::optional<std::filesystem::path> {};
+    auto output = std::optional<std::filesystem::path> {};
+    auto options = PackOptions {.plugins = builtin_plugins};
+    for (size_t i = 2; i < args.size(); i++) {
+        const auto arg = std::string_view {args[i]};
+        if ((arg == "-o" || arg == "--output") && i + 1 < args.size()) {
+            output = args[++i];
+        } else if (arg == "--compress") {
+            options.compress_textures = true;
+        } else if (!arg.starts_with("-") && !game_dir) {
+            game_dir = arg;
+        } else {
+            fmt::println(stderr, PACK_USAGE, args[0]);
+            return 1;
+        }
+    }
+
+    if (!game_dir) {
+        fmt::println(stderr, PACK_USAGE, args[0]);
+        return 1;
+    }
+    if (!output) {
+        auto dir = std::filesystem::absolute(*game_dir).lexically_normal();
+        if (!dir.has_filename()) dir = dir.parent_path();
+        output = dir.filename().concat(".zip");
+    }
+
+    if (auto r = pack_game(*game_dir, *output, options); !r) {
+        fmt::println(stderr, "Error packing game: {}", r.error()->msg());
+        if (auto loc = r.error()->loc_str()) fmt::println("Originated from:\n    {}", *loc);
+        return 1;
+    }
+    return 0;
+} catch (std::exception& e) {
+    // NOLINTNEXTLINE: fmt::println throws exception
+    fprintf(stderr, "Unexpected error: %s\n", e.what());
+    return 1;
+}
+
+static constexpr auto BAKE_USAGE = "Usage: {} bake GAME_DIR";
+
+/// `glint bake` subcommand
+static auto bake(std::span<char *> args) noexcept -> int try {
+    using namespace glint;
+
+    if (args.size() != 3 || std::string_view {args[2]}.starts_with("-")) {
+        fmt::println(stderr, BAKE_USAGE, args[0]);
+        return 1;
+    }
+
+    if (auto r = bake_atlases(args[2]); !r) {
+        fmt::println(stderr, "Error baking atlases: {}", r.error()->msg());
+        if (auto loc = r.error()->loc_str()) fmt::println("Originated from:\n    {}", *loc);
+        return 1;
+    }
+    return 0;
+} catch (std::exception& e) {
+    // NOLINTNEXTLINE: fmt::println throws exception
+    fprintf(stderr, "Unexpected error: %s\n", e.what());
+    return 1;
+}
+
+template<typename T>
+static auto parse_number(std::string_view str, T& out) noexcept -> bool {
+    const auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), out);
+    return ec == std::errc {} && end == str.data() + str.size();
+}
 
 auto main(int argc, char **argv) noexcept -> int try {
     using namespace glint;
@@ -21,9 +121,55 @@ auto main(int argc, char **argv) noexcept -> int try {
 
     auto args = std::span(argv, size_t(argc));
 
-    auto path_str = args[0];
-    if (argc == 2) {
-        path_str = argv[1];
+    // Game directory or archive named like subcommand still runs
+    const auto is_subcommand = [&](std::string_view name) {
+        auto ec = std::error_code {};
+        return args.size() >= 2 && std::string_view {args[1]} == name && !std::filesystem::exists(args[1], ec);
+    };
+    if (is_subcommand("pack")) return pack(args);
+    if (is_subcommand("bake")) return bake(args);
+
+    auto path_str = std::string_view {args[0]};
+    auto options = RunOptions {};
+    for (size_t i = 1; i < args.size(); i++) {
+        const auto arg = std::string_view {args[i]};
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--trace-bindings") {
+            binding_trace::enable();
+        } else if (arg == "--frames" || arg == "--dt") {
+            if (i + 1 >= args.size()) {
+                fmt::println(stderr, "Missing value for {}", arg);
+                fmt::println(stderr, USAGE, args[0]);
+                return 1;
+            }
+            const auto value = std::string_view {args[++i]};
+            const auto parsed = arg == "--frames" ? parse_number(value, options.frames.emplace())
+                                                  : parse_number(value, options.dt.emplace());
+            if (!parsed) {
+                fmt::println(stderr, "Invalid value for {}: `{}`", arg, value);
+                return 1;
+            }
+        } else if (arg == "--profile") {
+            if (i + 1 >= args.size()) {
+                fmt::println(stderr, "Missing value for {}", arg);
+                fmt::println(stderr, USAGE, args[0]);
+                return 1;
+            }
+            options.trace = std::filesystem::path {args[++i]};
+        } else if (arg.starts_with("--")) {
+            fmt::println(stderr, "Unknown option {}", arg);
+            fmt::println(stderr, USAGE, args[0]);
+            return 1;
+        } else {
+            path_str = arg;
+        }
+    }
+
+    // Enabled before engine is created, so that loading of game modules is profiled too
+    if (options.trace) {
+        profiler::enable();
+        profiler::name_thread("Main");
     }
 
     const auto path = std::filesystem::path(path_str);
@@ -37,11 +183,7 @@ auto main(int argc, char **argv) noexcept -> int try {
     auto engine = std::move(*engine_result);
 
     SPDLOG_TRACE("Registering plugins");
-    engine->register_plugin(plugins::console::plugin(engine->js_context()));
-    engine->register_plugin(plugins::math::plugin(engine->js_context()));
-    engine->register_plugin(plugins::window::plugin(engine->js_context()));
-    engine->register_plugin(plugins::graphics::plugin(engine->js_context()));
-    engine->register_plugin(plugins::audio::plugin(engine->js_context()));
+    for (const auto& plugin : builtin_plugins(engine->js_context())) engine->register_plugin(plugin);
 
     if (auto r = engine->load_plugins(); !r) {
         fmt::println("Error loading plugins: {}", r.error()->msg());
@@ -57,7 +199,7 @@ auto main(int argc, char **argv) noexcept -> int try {
     }
     auto game = std::move(*game_result);
 
-    const auto run_result = engine->run_game(game);
+    const auto run_result = engine->run_game(game, options);
     if (!run_result) {
         fmt::println(stderr, "Error running game: {}", run_result.error()->msg());
         if (auto loc = run_result.error()->loc_str()) fmt::println("Originated from:\n    {}", *loc);
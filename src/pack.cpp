@@ -0,0 +1,399 @@
+#include <pack.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <quickjs.h>
+#include <spdlog/spdlog.h>
+#include <zip.h>
+
+#include <atlas.hpp>
+#include <bytecode_cache.hpp>
+#include <defer.hpp>
+#include <file_store.hpp>
+#include <quickjs.hpp>
+#include <raylib.hpp>
+#include <texture_container.hpp>
+
+namespace glint {
+
+/// Formats that won't shrink when deflated
+static constexpr auto STORED_EXTENSIONS = std::array<std::string_view, 7> {
+    ".png",
+    ".jpg",
+    ".jpeg",
+    ".qoi",
+    ".mp3",
+    ".ogg",
+    ".flac",
+};
+
+/// Images that are baked into atlas when found in sprite folder, or can be compressed
+static constexpr auto IMAGE_EXTENSIONS = std::array<std::string_view, 7> {
+    ".png",
+    ".jpg",
+    ".jpeg",
+    ".qoi",
+    ".bmp",
+    ".tga",
+    ".gif",
+};
+
+static auto lower_extension(const std::filesystem::path& path) -> std::string {
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return ext;
+}
+
+static auto should_store(const std::filesystem::path& path) -> bool {
+    return std::ranges::find(STORED_EXTENSIONS, lower_extension(path)) != STORED_EXTENSIONS.end();
+}
+
+static auto is_image(const std::filesystem::path& path) -> bool {
+    return std::ranges::find(IMAGE_EXTENSIONS, lower_extension(path)) != IMAGE_EXTENSIONS.end();
+}
+
+static auto is_atlas_folder(const std::filesystem::path& path) -> bool {
+    return path.extension() == ATLAS_FOLDER_EXTENSION && std::filesystem::is_directory(path);
+}
+
+/// Whether file relative to game directory is inside sprite folder, or is what was baked from one
+static auto belongs_to_atlas(const std::filesystem::path& game_dir, const std::filesystem::path& rel) -> bool {
+    for (auto dir = rel.parent_path(); !dir.empty(); dir = dir.parent_path()) {
+        if (dir.extension() == ATLAS_FOLDER_EXTENSION) return true;
+    }
+
+    // `<folder>.bin` or `<folder>.<page>.png`
+    auto folder = rel;
+    if (rel.extension() == ".png") {
+        folder.replace_extension();
+        const auto page = folder.extension().string();
+        if (page.size() < 2 || page.find_first_not_of(".0123456789") != std::string::npos) return false;
+    } else if (rel.extension() != ".bin") {
+        return false;
+    }
+    folder.replace_extension();
+    return folder.extension() == ATLAS_FOLDER_EXTENSION && std::filesystem::is_directory(game_dir / folder);
+}
+
+/// Smallest side of image worth block compression, small sprites would only lose quality
+static constexpr auto MIN_COMPRESSED_SIDE = 256;
+
+/// DDS of large RGBA image whose sides are multiple of 4, as block compression needs
+static auto transcode(const rl::Image& image) -> std::optional<std::vector<unsigned char>> {
+    if (image.width < MIN_COMPRESSED_SIDE || image.height < MIN_COMPRESSED_SIDE) return std::nullopt;
+    if (image.width % 4 != 0 || image.height % 4 != 0) return std::nullopt;
+    auto dds = encode_dds(image);
+    if (!dds) {
+        SPDLOG_WARN("Could not compress texture: {}", dds.error()->msg());
+        return std::nullopt;
+    }
+    return std::move(*dds);
+}
+
+struct BakedAtlas {
+    std::vector<unsigned char> index {};
+    std::vector<std::vector<unsigned char>> pages {};
+    /// Compressed copy of every page that suits it, stored under `compressed_texture_path` of page
+    std::vector<std::optional<std::vector<unsigned char>>> compressed_pages {};
+    size_t images = 0;
+};
+
+/// Pack every image inside sprite folder into PNG pages, and DDS copies of them when `compress` is set.
+/// Regions are named by image path relative to folder
+static auto bake_atlas(const std::filesystem::path& folder, bool compress) -> Result<BakedAtlas> {
+    auto paths = std::vector<std::filesystem::path> {};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(folder)) {
+        if (!entry.is_regular_file()) continue;
+        if (!is_image(entry.path())) continue;
+        paths.push_back(entry.path());
+    }
+    // Directory order is not stable, sorting keeps baked output same between runs
+    std::ranges::sort(paths);
+
+    auto names = std::vector<std::string> {};
+    auto images = std::vector<rl::Image> {};
+    for (const auto& path : paths) {
+        auto buf = MappedBuffer::map_file(path);
+        if (!buf) return err(buf);
+        auto image = rl::Image::load_from_memory(path.extension().string().c_str(), buf->bytes());
+        if (!::IsImageValid(image)) return err(fmt::format("Could not decode image {}", path.string()));
+        names.push_back(std::filesystem::relative(path, folder).generic_string());
+        images.push_back(std::move(image));
+    }
+
+    auto atlas = compose_atlas(std::move(names), images, DEFAULT_ATLAS_PAGE_SIZE, DEFAULT_ATLAS_PADDING);
+    if (!atlas) return err(atlas);
+    auto index = encode_atlas_index(atlas->index);
+    if (!index) return err(index);
+
+    auto baked = BakedAtlas {.index = std::move(*index), .images = images.size()};
+    for (const auto& page : atlas->pages) {
+        baked.pages.push_back(page.export_to_memory(".png"));
+        if (baked.pages.back().empty()) return err(fmt::format("Could not encode atlas page of {}", folder.string()));
+        baked.compressed_pages.push_back(compress ? transcode(page) : std::nullopt);
+    }
+    return baked;
+}
+
+/// Modules that imports of packed game resolve to
+struct PackModules {
+    std::map<std::string, JSModuleDef *> c_modules {};
+    std::map<std::string, std::string> js_modules {};
+    IFileStore *sources = nullptr;
+};
+
+/// Compile module without evaluating it. Its imports are resolved, so that missing modules and exports are reported
+static auto compile_only(not_null<JSContext *> js, std::string_view source, const std::string& name, int flags)
+    -> JSValue {
+    return JS_Eval(
+        js,
+        source.data(),
+        source.size(),
+        name.c_str(),
+        JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY | flags
+    );
+}
+
+/// Resolve module like engine `module_loader` does: native modules of plugins, builtin JS modules, then game modules
+/// read from sources being packed. Game modules are compiled here only to resolve imports, they are stored when
+/// packer reaches their files
+static auto pack_module_loader(JSContext *js, const char *module_name, void *opaque) noexcept -> JSModuleDef * try {
+    const auto& modules = *static_cast<const PackModules *>(opaque);
+    const auto name = std::string {module_name};
+    if (auto cm = modules.c_modules.find(name); cm != modules.c_modules.end()) return cm->second;
+
+    auto compiled = JSValue {};
+    if (auto jm = modules.js_modules.find(name); jm != modules.js_modules.end()) {
+        compiled = compile_only(js, jm->second, name, 0);
+    } else {
+        auto path = std::filesystem::path {name};
+        if (!path.has_extension()) path += ".js";
+        const auto source = modules.sources->read_string(path);
+        if (!source) {
+            JS_ThrowReferenceError(js, "Could not load module %s: %s", module_name, source.error()->msg().c_str());
+            return nullptr;
+        }
+        compiled = compile_only(js, *source, name, 0);
+    }
+
+    if (JS_IsException(compiled)) return nullptr;
+    auto mod = static_cast<JSModuleDef *>(JS_VALUE_GET_PTR(compiled));
+    JS_FreeValue(js, compiled);
+    return mod;
+} catch (std::exception& e) {
+    JS_ThrowInternalError(js, "Could not load module %s: %s", module_name, e.what());
+    return nullptr;
+}
+
+/// Compile module the same way engine does, naming it by its path inside the game
+static auto compile_module(not_null<JSContext *> js, const std::string& source, const std::string& name)
+    -> Result<std::vector<uint8_t>> {
+    // Game::create compiles entry module in strict mode
+    const auto flags = name == "game.js" ? JS_EVAL_FLAG_STRICT : 0;
+    auto compiled = compile_only(js, source, name, flags);
+    if (JS_IsException(compiled)) return err(js::JSError::from_value(js::own(js, JS_GetException(js))));
+    defer(JS_FreeValue(js, compiled));
+    return BytecodeCache::serialize(js, compiled);
+}
+
+static auto add_entry(zip_t *zip, const std::string& name, zip_source_t *source, bool store) -> Result<> {
+    if (source == nullptr) return err(fmt::format("Could not read {}: {}", name, zip_strerror(zip)));
+
+    const auto index = zip_file_add(zip, name.c_str(), source, ZIP_FL_ENC_UTF_8 | ZIP_FL_OVERWRITE);
+    if (index < 0) {
+        zip_source_free(source);
+        return err(fmt::format("Could not add {}: {}", name, zip_strerror(zip)));
+    }
+
+    const auto method = store ? ZIP_CM_STORE : ZIP_CM_DEFLATE;
+    if (zip_set_file_compression(zip, zip_uint64_t(index), method, 0) < 0) {
+        return err(fmt::format("Could not set compression for {}: {}", name, zip_strerror(zip)));
+    }
+
+    return {};
+}
+
+/// Add copy of `bytes` to archive
+static auto add_buffer(zip_t *zip, const std::string& name, std::span<const unsigned char> bytes, bool store)
+    -> Result<> {
+    // libzip reads source buffer on close and frees it with free()
+    auto buf = std::malloc(bytes.size()); // NOLINT: ownership is passed to libzip
+    if (buf == nullptr) return err("Out of memory");
+    std::memcpy(buf, bytes.data(), bytes.size());
+    auto source = zip_source_buffer(zip, buf, bytes.size(), 1);
+    if (source == nullptr) std::free(buf); // NOLINT
+    return add_entry(zip, name, source, store);
+}
+
+auto bake_atlases(const std::filesystem::path& game_dir) noexcept -> Result<> try {
+    auto atlases = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(game_dir)) {
+        if (!is_atlas_folder(entry.path())) continue;
+        const auto rel = std::filesystem::relative(entry.path(), game_dir);
+        if (belongs_to_atlas(game_dir, rel)) continue;
+
+        auto baked = bake_atlas(entry.path(), false);
+        if (!baked) return err(baked);
+
+        const auto write = [&](const std::filesystem::path& path, std::span<const unsigned char> bytes) -> Result<> {
+            auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(bytes.data()), std::streamsize(bytes.size())); // NOLINT
+            if (!file) return err(fmt::format("Could not write {}", path.string()));
+            return {};
+        };
+        if (auto r = write(atlas_index_path(entry.path()), baked->index); !r) return r;
+        for (size_t i = 0; i < baked->pages.size(); i++) {
+            if (auto r = write(atlas_page_path(entry.path(), i), baked->pages[i]); !r) return r;
+        }
+        fmt::println("Baked {}: {} images into {} pages", rel.generic_string(), baked->images, baked->pages.size());
+        atlases++;
+    }
+
+    if (atlases == 0) fmt::println("No {} folders found in {}", ATLAS_FOLDER_EXTENSION, game_dir.string());
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Compressed copy of image file, if it is worth compressing
+static auto compress_image(const std::filesystem::path& path) -> std::optional<std::vector<unsigned char>> {
+    auto buf = MappedBuffer::map_file(path);
+    if (!buf || is_texture_container(buf->bytes())) return std::nullopt;
+    auto image = rl::Image::load_from_memory(path.extension().string().c_str(), buf->bytes());
+    if (!::IsImageValid(image)) return std::nullopt;
+    image.convert(PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return transcode(image);
+}
+
+auto pack_game(const std::filesystem::path& game_dir, const std::filesystem::path& output, const PackOptions& options)
+    noexcept -> Result<> try {
+    if (!std::filesystem::is_regular_file(game_dir / "game.js")) {
+        return err(fmt::format("`{}` is not a game directory: game.js not found", game_dir.string()));
+    }
+
+    auto runtime = JS_NewRuntime();
+    if (runtime == nullptr) return err("Could not allocate runtime");
+    defer(JS_FreeRuntime(runtime));
+    auto js = JS_NewContext(runtime);
+    if (js == nullptr) return err("Could not allocate context");
+    defer(JS_FreeContext(js));
+
+    auto sources = FilesystemStore::open(game_dir);
+    if (!sources) return err(sources);
+
+    auto imports = PackModules {.sources = &*sources};
+    if (options.plugins) {
+        for (auto& plugin : options.plugins(js)) {
+            imports.c_modules.merge(plugin.c_modules);
+            imports.js_modules.merge(plugin.js_modules);
+        }
+    }
+    JS_SetModuleLoaderFunc(runtime, nullptr, pack_module_loader, &imports);
+
+    auto ec = int {};
+    auto zip = zip_open(output.string().c_str(), ZIP_CREATE | ZIP_TRUNCATE, &ec);
+    if (zip == nullptr) {
+        auto e = zip_error_t {};
+        zip_error_init_with_code(&e, ec);
+        defer(zip_error_fini(&e));
+        return err(fmt::format("Could not create archive `{}`: {}", output.string(), zip_error_strerror(&e)));
+    }
+    // Closed explicitly on success, archive is not written if anything fails
+    auto written = false;
+    defer(if (!written) zip_discard(zip));
+
+    const auto output_abs = std::filesystem::weakly_canonical(output);
+    auto modules = 0;
+    auto atlases = 0;
+    auto compressed = 0;
+    auto stored = 0;
+    auto deflated = 0;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(game_dir)) {
+        const auto rel = std::filesystem::relative(entry.path(), game_dir);
+
+        // Sprite folder goes into archive only as its atlas, previously baked files are replaced
+        if (is_atlas_folder(entry.path()) && !belongs_to_atlas(game_dir, rel)) {
+            auto baked = bake_atlas(entry.path(), options.compress_textures);
+            if (!baked) return err(baked);
+            const auto index_name = atlas_index_path(rel).generic_string();
+            if (auto r = add_buffer(zip, index_name, baked->index, false); !r) return r;
+            for (size_t i = 0; i < baked->pages.size(); i++) {
+                const auto page_name = atlas_page_path(rel, i).generic_string();
+                if (auto r = add_buffer(zip, page_name, baked->pages[i], true); !r) return r;
+                // Texture loader of atlas prefers compressed copy next to page, like with any other image
+                if (const auto& dds = baked->compressed_pages[i]) {
+                    const auto dds_name = compressed_texture_path(atlas_page_path(rel, i)).generic_string();
+                    if (auto r = add_buffer(zip, dds_name, *dds, true); !r) return r;
+                    compressed++;
+                }
+            }
+            SPDLOG_INFO("Baked {} ({} images into {} pages)", rel.generic_string(), baked->images, baked->pages.size());
+            atlases++;
+            continue;
+        }
+
+        if (!entry.is_regular_file()) continue;
+        if (std::filesystem::weakly_canonical(entry.path()) == output_abs) continue;
+        if (belongs_to_atlas(game_dir, rel)) continue;
+
+        auto name = rel.generic_string();
+
+        if (rel.extension() == ".js") {
+            auto source = sources->read_string(rel);
+            if (!source) return err(source);
+
+            auto bytecode = compile_module(js, *source, name);
+            if (!bytecode) return err(bytecode);
+
+            name = std::filesystem::path {rel}.replace_extension(PRECOMPILED_MODULE_EXTENSION).generic_string();
+            if (auto r = add_buffer(zip, name, *bytecode, true); !r) return r;
+            SPDLOG_INFO("Compiled {} ({} bytes of bytecode)", rel.generic_string(), bytecode->size());
+            modules++;
+        } else {
+            // Compressed copy goes next to image, which stays for anything decoding its pixels.
+            // Texture loader prefers the copy, so game code does not change
+            if (auto dds = options.compress_textures && is_image(rel) ? compress_image(entry.path()) : std::nullopt) {
+                const auto dds_name = compressed_texture_path(rel).generic_string();
+                if (auto r = add_buffer(zip, dds_name, *dds, true); !r) return r;
+                SPDLOG_INFO("Compressed {} ({} bytes)", name, dds->size());
+                compressed++;
+            }
+
+            const auto store = should_store(rel);
+            auto source = zip_source_file(zip, entry.path().string().c_str(), 0, ZIP_LENGTH_TO_END);
+            if (auto r = add_entry(zip, name, source, store); !r) return r;
+            SPDLOG_INFO("{} {}", store ? "Stored" : "Deflated", name);
+            (store ? stored : deflated)++;
+        }
+    }
+
+    if (zip_close(zip) < 0) return err(fmt::format("Could not write archive: {}", zip_strerror(zip)));
+    written = true;
+
+    fmt::println(
+        "Packed {} into {}: {} modules, {} atlases, {} compressed textures, {} stored and {} deflated assets",
+        game_dir.string(),
+        output.string(),
+        modules,
+        atlases,
+        compressed,
+        stored,
+        deflated
+    );
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace glint
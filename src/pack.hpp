@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include <engine/plugin.hpp>
+#include <error.hpp>
+
+namespace glint {
+
+/// Extension of precompiled module stored in packed game instead of `.js` source
+constexpr auto PRECOMPILED_MODULE_EXTENSION = ".jsc";
+
+struct PackOptions {
+    /// Add DXT compressed DDS copy of images and atlas pages of at least 256x256, see `compressed_texture_path`
+    bool compress_textures = false;
+    /// Plugins whose modules game imports, created on context of packer. Their modules are only declared, so that
+    /// imports resolve while compiling, and are never evaluated
+    std::function<auto(JSContext *)->std::vector<plugins::EnginePlugin>> plugins = nullptr;
+};
+
+/// Pack game directory into zip archive that can be run directly.
+/// Every `.js` module is replaced with its QuickJS bytecode (`.jsc`). Bytecode and assets that are already compressed
+/// (images, audio) are stored as is, so that reading them does not need inflating, everything else is deflated.
+/// Sprite folders (`*.atlas`) are replaced with atlas baked from their images, see `bake_atlases`.
+[[nodiscard]]
+auto pack_game(
+    const std::filesystem::path& game_dir,
+    const std::filesystem::path& output,
+    const PackOptions& options = {}
+) noexcept -> Result<>;
+
+/// Bake every sprite folder (`*.atlas`) in game directory into atlas next to it: `<folder>.bin` index of regions and
+/// `<folder>.<page>.png` pages. Game loads it with `new Atlas("<folder>")`, decoding only the pages
+[[nodiscard]]
+auto bake_atlases(const std::filesystem::path& game_dir) noexcept -> Result<>;
+
+} // namespace glint
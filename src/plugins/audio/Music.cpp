@@ -6,6 +6,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
 #include <engine/audio.hpp>
 #include <engine.hpp>
 
@@ -53,6 +54,39 @@ static auto music_constructor(JSContext *js, JSValue new_target, int argc, JSVal
     return obj;
 }
 
+static auto music_load(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Music.load/{}", argc);
+    auto args = js::unpack_args<std::string>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    auto [filename] = std::move(*args);
+    auto promise = js::Promise::create(js);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(js);
+
+    auto result = promise->object();
+    e.asset_loader().submit(
+        [&store = e.file_store(), path = std::filesystem::path {filename}] { return music::prepare(path, store); },
+        [promise = std::move(*promise)](Result<music::Source>&& source) mutable {
+            const auto js = promise.ctx();
+            auto music_result = source ? music::finish(std::move(*source)) : Result<Music> {err(source)};
+            if (!music_result) {
+                auto message = fmt::format("Could not load music: {}", music_result.error()->msg());
+                return promise.reject(js::JSError::plain_error(js, message));
+            }
+
+            auto obj = js::own(js, JS_NewObjectClass(js, int(js::class_id<&MUSIC>(js))));
+            if (JS_IsException(obj.cget())) {
+                return promise.reject(js::JSError::from_value(js::own(js, JS_GetException(js))));
+            }
+            auto music = owner<Music *>(new Music {std::move(*music_result)});
+            audio::get().musics.insert(music);
+            JS_SetOpaque(obj.cget(), music);
+            promise.resolve(obj);
+        }
+    );
+    return result;
+}
+
 static auto music_unload(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
     auto m = try_into<audio::Music *>(js::borrow(js, this_val));
     if (!m) return jsthrow(m.error());
@@ -181,6 +215,10 @@ static const auto PROTO_FUNCS = std::array {
     JSCFunctionListEntry JS_CGETSET_DEF("pitch", music_get_pitch, music_set_pitch),
 };
 
+static const auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("load", 1, music_load),
+};
+
 extern const JSClassDef MUSIC = {
     .class_name = "Music",
     .finalizer = nullptr,
@@ -198,6 +236,7 @@ auto module(JSContext *js) -> JSModuleDef * {
         JS_SetClassProto(js, js::class_id<&MUSIC>(js), proto);
 
         JSValue ctor = JS_NewCFunction2(js, music_constructor, "Music", 1, JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
         JS_SetConstructor(js, ctor, proto);
 
         JS_SetModuleExport(js, m, "default", ctor);
@@ -6,6 +6,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
 #include <engine.hpp>
 
 namespace glint::js {
@@ -51,6 +52,38 @@ static auto sound_constructor(JSContext *js, JSValue new_target, int argc, JSVal
     return obj;
 }
 
+static auto sound_load(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Sound.load/{}", argc);
+    auto args = js::unpack_args<std::string>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    auto [filename] = std::move(*args);
+    auto promise = js::Promise::create(js);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(js);
+
+    auto result = promise->object();
+    e.asset_loader().submit(
+        [&store = e.file_store(), path = std::filesystem::path {filename}] { return sound::decode(path, store); },
+        [promise = std::move(*promise)](Result<rl::Wave>&& wave) mutable {
+            const auto js = promise.ctx();
+            if (!wave) {
+                auto message = fmt::format("Could not load sound: {}", wave.error()->msg());
+                return promise.reject(js::JSError::plain_error(js, message));
+            }
+
+            auto obj = js::own(js, JS_NewObjectClass(js, int(js::class_id<&SOUND>(js))));
+            if (JS_IsException(obj.cget())) {
+                return promise.reject(js::JSError::from_value(js::own(js, JS_GetException(js))));
+            }
+            auto sound = owner<Sound *>(new Sound {sound::from_wave(*wave)});
+            audio::get().sounds.insert(sound);
+            JS_SetOpaque(obj.cget(), sound);
+            promise.resolve(obj);
+        }
+    );
+    return result;
+}
+
 static auto sound_unload(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
     auto s = js::try_into<audio::Sound *>(js::borrow(js, this_val));
     if (!s) return jsthrow(s.error());
@@ -135,6 +168,10 @@ const static auto PROTO_FUNCS = std::array {
     JSCFunctionListEntry JS_CGETSET_DEF("pitch", sound_get_pitch, sound_set_pitch),
 };
 
+const static auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("load", 1, sound_load),
+};
+
 static const auto SOUND_CLASS = JSClassDef {
     .class_name = "Sound",
     .finalizer = nullptr,
@@ -153,6 +190,7 @@ auto module(JSContext *js) -> JSModuleDef * {
         JS_SetClassProto(js, id, proto);
 
         JSValue ctor = JS_NewCFunction2(js, sound_constructor, "Sound", 1, JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
         JS_SetConstructor(js, ctor, proto);
 
         JS_SetModuleExport(js, m, "default", ctor);
@@ -12,14 +12,6 @@ auto plugin(JSContext *js) -> EnginePlugin {
                 {"glint:Music", music_class::module(js)},
                 {"glint:Sound", sound_class::module(js)},
             },
-        .load = []() -> Result<> {
-            engine::audio::init();
-            return {};
-        },
-        .unload = []() -> Result<> {
-            engine::audio::close();
-            return {};
-        },
         .update = []() -> Result<> {
             for (const auto music : engine::audio::get().musics) {
                 if (engine::audio::music::is_playing(*music)) {
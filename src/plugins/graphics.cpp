@@ -1,8 +1,12 @@
+#include "./graphics/Atlas.cpp"
 #include "./graphics/Camera.cpp"
 #include "./graphics/Color.cpp"
 #include "./graphics/Font.cpp"
 #include "./graphics/NPatch.cpp"
+#include "./graphics/ParticleEmitter.cpp"
 #include "./graphics/RenderTexture.cpp"
+#include "./graphics/SpriteBatch.cpp"
+#include "./graphics/TextLayout.cpp"
 #include "./graphics/Texture.cpp"
 #include "./graphics/descriptor.cpp"
 #include "./graphics/graphics.cpp"
@@ -1,14 +1,27 @@
 #pragma once
 
+#include <random>
+#include <string>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include <raylib.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atlas.hpp>
 #include <engine/plugin.hpp>
 #include <quickjs.hpp>
 #include <data.hpp>
 
+namespace glint::plugins::graphics::texture {
+    /// Part of texture to draw: whole Texture or region of atlas page
+    struct TextureRegion {
+        const rl::Texture *texture;
+        Rectangle source;
+    };
+} // namespace glint::plugins::graphics::texture
+
 namespace glint::js {
 
 template<>
@@ -26,6 +39,10 @@ auto try_into<NPatchInfo>(const Value& val) noexcept -> JSResult<NPatchInfo>;
 template<>
 auto try_into<const rl::Texture *>(const Value& val) noexcept -> JSResult<const rl::Texture *>;
 
+template<>
+auto try_into<plugins::graphics::texture::TextureRegion>(const Value& val) noexcept
+    -> JSResult<plugins::graphics::texture::TextureRegion>;
+
 template<>
 auto try_into<const rl::RenderTexture *>(const Value& val) noexcept -> JSResult<const rl::RenderTexture *>;
 
@@ -39,6 +56,45 @@ using namespace gsl;
 auto module(JSContext *js) -> JSModuleDef *;
 auto plugin(JSContext *js) -> EnginePlugin;
 
+namespace atlas {
+    struct AtlasOptions {
+        int page_size = DEFAULT_ATLAS_PAGE_SIZE;
+        int padding = DEFAULT_ATLAS_PADDING;
+    };
+
+    struct AtlasPackImages {
+        std::vector<std::string> paths;
+        AtlasOptions options;
+    };
+
+    /// Sprite folder baked by `glint pack` or `glint bake`
+    struct AtlasLoadBaked {
+        std::string folder;
+    };
+
+    using AtlasSource = std::variant<AtlasPackImages, AtlasLoadBaked>;
+
+    struct AtlasRegion {
+        size_t page;
+        Rectangle source;
+    };
+
+    struct AtlasClassData {
+        std::vector<ResourceStore<TextureData>::Handle> pages;
+        std::unordered_map<std::string, AtlasRegion> regions;
+    };
+
+    /// Region keeps its own reference to page, so it stays drawable after Atlas object is collected
+    struct RegionClassData {
+        ResourceStore<TextureData>::Handle page;
+        Rectangle source;
+    };
+
+    extern const JSClassDef ATLAS;
+    extern const JSClassDef ATLAS_REGION;
+    auto module(JSContext *js) -> JSModuleDef *;
+} // namespace atlas
+
 namespace camera {
     struct CameraClassData {
         Camera2D camera {};
@@ -71,6 +127,7 @@ namespace font {
         std::optional<std::string> name {};
         std::optional<int> font_size {};
         std::optional<std::vector<int>> codepoints {};
+        std::optional<bool> dynamic {};
     };
 
     struct FontLoadByName {
@@ -82,6 +139,8 @@ namespace font {
         std::string name;
         int font_size;
         std::optional<std::vector<int>> codepoints;
+        /// Rasterize glyphs when they are first drawn instead of at load, see `GlyphCache`
+        bool dynamic;
     };
 
     using FontLoadMode = std::variant<std::monostate, FontLoadByName, FontLoadByParams>;
@@ -101,6 +160,67 @@ namespace npatch {
     auto module(::JSContext *js) -> ::JSModuleDef *;
 } // namespace npatch
 
+namespace particle_emitter {
+    /// Value picked uniformly between `min` and `max` for every particle
+    struct Range {
+        float min;
+        float max;
+    };
+
+    struct EmitterConfig {
+        /// Seconds
+        Range lifetime;
+        /// Pixels per second
+        Range speed;
+        /// Direction of initial velocity in degrees
+        Range angle;
+        /// Rotation speed in degrees per second
+        Range spin;
+        float start_size;
+        float end_size;
+        Color start_color;
+        Color end_color;
+        Vector2 gravity;
+        /// Fraction of velocity lost per second
+        float drag;
+    };
+
+    /// State of live particles, each attribute in its own array, so that every update pass streams over contiguous
+    /// floats. Arrays are allocated for full capacity once, first `count` particles are alive
+    struct Particles {
+        /// xy pairs
+        std::vector<float> positions {};
+        /// xy pairs
+        std::vector<float> velocities {};
+        std::vector<float> ages {};
+        std::vector<float> lifetimes {};
+        std::vector<float> rotations {};
+        std::vector<float> spins {};
+        size_t count = 0;
+    };
+
+    struct ParticleEmitterClassData {
+        /// 0 when particles are drawn as plain squares
+        ResourceStore<TextureData>::Handle texture;
+        /// Whole texture when not set
+        std::optional<Rectangle> source;
+        EmitterConfig config;
+        Vector2 position;
+        /// Particles emitted per second by `update`
+        float rate;
+        /// Fraction of particle to be emitted by next `update`
+        float pending = 0;
+        size_t capacity;
+        Particles particles {};
+        std::minstd_rand random {};
+
+        static auto from_value(const Value& val) -> JSResult<ParticleEmitterClassData *>;
+    };
+
+    extern const JSClassDef PARTICLE_EMITTER;
+    auto module(JSContext *js) -> JSModuleDef *;
+} // namespace particle_emitter
+
 namespace render_texture {
     struct RenderTextureClassData {
         rl::RenderTexture texture {};
@@ -113,6 +233,56 @@ namespace render_texture {
     auto to_string(RenderTexture texture) -> std::string;
 } // namespace render_texture
 
+namespace sprite_batch {
+    /// Number of floats in one sprite record:
+    /// x, y, source x, source y, source width, source height, rotation, scale x, scale y, r, g, b, a
+    constexpr size_t STRIDE = 13;
+
+    /// Max sprites submitted between render batch limit checks
+    constexpr size_t CHUNK_SIZE = 1024;
+
+    struct SpriteBatchClassData {
+        ResourceStore<TextureData>::Handle texture;
+
+        static auto from_value(const Value& val) -> JSResult<SpriteBatchClassData *>;
+    };
+
+    extern const JSClassDef SPRITE_BATCH;
+    auto module(JSContext *js) -> JSModuleDef *;
+} // namespace sprite_batch
+
+namespace text_layout {
+    /// Line spacing of raylib text drawing functions, so that layout matches `graphics.textPro`
+    constexpr float LINE_SPACING = 2;
+
+    struct GlyphQuad {
+        Rectangle source;
+        Rectangle dest;
+    };
+
+    struct TextLayoutClassData {
+        /// 0 when layout uses raylib default font
+        ResourceStore<FontData>::Handle font;
+        std::string text;
+        float font_size;
+        float spacing;
+
+        /// Quads relative to layout origin, valid while `dirty` is false
+        std::vector<GlyphQuad> quads {};
+        Vector2 size {};
+        /// Glyphs of font quads were made from, so layout is redone after font reload
+        const ::GlyphInfo *glyphs = nullptr;
+        /// Glyph cache generation of dynamic font, so layout is redone after its glyphs move
+        uint64_t generation = 0;
+        bool dirty = true;
+
+        static auto from_value(const Value& val) -> JSResult<TextLayoutClassData *>;
+    };
+
+    extern const JSClassDef TEXT_LAYOUT;
+    auto module(JSContext *js) -> JSModuleDef *;
+} // namespace text_layout
+
 namespace texture {
     struct TextureClassData {
         ResourceStore<TextureData>::Handle handle;
@@ -137,6 +307,9 @@ namespace texture {
 
     extern const JSClassDef TEXTURE;
     auto module(JSContext *js) -> JSModuleDef *;
+
+    /// Wrap already referenced handle into Texture object with default prototype
+    auto wrap(JSContext *js, ResourceStore<TextureData>::Handle handle) -> js::Value;
 } // namespace texture
 
 } // namespace glint::plugins::graphics
@@ -0,0 +1,413 @@
+#include <plugins/graphics.hpp>
+
+#include <array>
+#include <gsl/gsl>
+
+#include <fmt/format.h>
+#include <raylib.h>
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <atlas.hpp>
+#include <defer.hpp>
+#include <engine.hpp>
+#include <error.hpp>
+#include <plugins/math.hpp>
+
+namespace glint::js {
+
+using plugins::graphics::atlas::ATLAS_REGION;
+using plugins::graphics::atlas::AtlasOptions;
+using plugins::graphics::atlas::RegionClassData;
+using plugins::graphics::texture::TEXTURE;
+using plugins::graphics::texture::TextureClassData;
+using plugins::graphics::texture::TextureRegion;
+
+template<>
+auto try_into<TextureRegion>(const Value& val) noexcept -> JSResult<TextureRegion> {
+    auto& store = Engine::get(val.ctx()).texture_store();
+
+    if (const auto data = static_cast<TextureClassData *>(JS_GetOpaque(val.cget(), class_id<&TEXTURE>(val.ctx())))) {
+        const auto& texture = store.borrow(data->handle);
+        const auto source = Rectangle {
+            .x = 0.0f,
+            .y = 0.0f,
+            .width = static_cast<float>(texture.width),
+            .height = static_cast<float>(texture.height),
+        };
+        return TextureRegion {.texture = &texture, .source = source};
+    }
+
+    const auto region = static_cast<RegionClassData *>(JS_GetOpaque(val.cget(), class_id<&ATLAS_REGION>(val.ctx())));
+    if (region == nullptr) return Unexpected(JSError::type_error(val.ctx(), "Expected Texture or AtlasRegion object"));
+    return TextureRegion {.texture = &store.borrow(region->page), .source = region->source};
+}
+
+template<>
+auto try_into<AtlasOptions>(const Value& val) noexcept -> JSResult<AtlasOptions> {
+    auto o = AtlasOptions {};
+    auto obj = Object::from_value(val);
+    if (!obj) return Unexpected(obj.error());
+
+    if (auto v = obj->at<std::optional<int>>("pageSize"); !v) return Unexpected(v.error());
+    else if (*v) o.page_size = **v;
+    if (auto v = obj->at<std::optional<int>>("padding"); !v) return Unexpected(v.error());
+    else if (*v) o.padding = **v;
+
+    return o;
+}
+
+} // namespace glint::js
+
+namespace glint::plugins::graphics::atlas {
+
+using namespace gsl;
+
+static auto read_atlas_source(not_null<JSContext *> js, int argc, JSValueConst *argv) -> js::JSResult<AtlasSource> {
+    if (argc < 1) return Unexpected(js::JSError::type_error(js, "Expected array of image paths or atlas folder"));
+    if (JS_IsString(argv[0])) {
+        auto folder = js::try_into<std::string>(js::borrow(js, argv[0]));
+        if (!folder) return Unexpected(folder.error());
+        return AtlasLoadBaked {.folder = std::move(*folder)};
+    }
+
+    auto paths = js::try_into<std::vector<std::string>>(js::borrow(js, argv[0]));
+    if (!paths) return Unexpected(paths.error());
+
+    auto options = AtlasOptions {};
+    if (argc > 1 && !JS_IsUndefined(argv[1])) {
+        auto o = js::try_into<AtlasOptions>(js::borrow(js, argv[1]));
+        if (!o) return Unexpected(o.error());
+        options = *o;
+    }
+    return AtlasPackImages {.paths = std::move(*paths), .options = options};
+}
+
+/// Decode and pack images, or read baked index and decode its pages. Does not touch GPU, so it can run on worker
+static auto compose(const AtlasSource& source, IFileStore& store) noexcept -> Result<ComposedAtlas> try {
+    if (const auto baked = std::get_if<AtlasLoadBaked>(&source)) {
+        const auto index_path = atlas_index_path(baked->folder);
+        const auto bytes = store.map(index_path);
+        if (!bytes) {
+            return err(fmt::format("Could not read atlas index {}: {}", index_path.string(), bytes.error()->msg()));
+        }
+        auto index = decode_atlas_index(bytes->bytes());
+        if (!index) return err(index);
+
+        auto atlas = ComposedAtlas {.index = std::move(*index)};
+        for (size_t i = 0; i < atlas.index.pages.size(); i++) {
+            auto page = TextureData::decode(atlas_page_path(baked->folder, i), store);
+            if (!page) return err(page);
+            atlas.pages.push_back(std::move(*page));
+        }
+        return atlas;
+    }
+
+    const auto& [paths, options] = std::get<AtlasPackImages>(source);
+    auto images = std::vector<rl::Image> {};
+    images.reserve(paths.size());
+    for (const auto& path : paths) {
+        auto image = TextureData::decode_image(path, store);
+        if (!image) return err(fmt::format("Could not load atlas image {}: {}", path, image.error()->msg()));
+        images.push_back(std::move(*image));
+    }
+    return compose_atlas(paths, images, options.page_size, options.padding);
+} catch (std::exception& e) {
+    return err(e);
+}
+
+/// Upload pages into texture store. Pages get unique names, so they are never shared with other atlases
+static auto upload(JSContext *js, const ComposedAtlas& atlas) -> AtlasClassData {
+    static auto next_id = uint32_t {};
+    const auto id = next_id++;
+
+    auto& store = Engine::get(js).texture_store();
+    auto data = AtlasClassData {};
+    for (size_t i = 0; i < atlas.pages.size(); i++) {
+        const auto name = fmt::format("atlas#{}/{}", id, i);
+        const auto& page = atlas.pages[i];
+        // Pages are unloaded as soon as nothing references them, so they are never reloaded
+        const auto handle = store.load(
+            name,
+            [&]() -> TextureData { return TextureData::from_image(name, page); },
+            []() -> TextureData { return {}; }
+        );
+        data.pages.push_back(handle);
+    }
+
+    const auto& index = atlas.index;
+    for (size_t i = 0; i < index.names.size(); i++) {
+        const auto& [page, rect] = index.placements[i];
+        const auto source = Rectangle {
+            .x = static_cast<float>(rect.x),
+            .y = static_cast<float>(rect.y),
+            .width = static_cast<float>(rect.width),
+            .height = static_cast<float>(rect.height),
+        };
+        data.regions.insert_or_assign(index.names[i], AtlasRegion {.page = page, .source = source});
+    }
+
+    SPDLOG_DEBUG("Loaded atlas of {} regions in {} pages", index.names.size(), atlas.pages.size());
+    return data;
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue;
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto load(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto region(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto page(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto unload(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto get_page_count(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_names(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue;
+
+static auto region_finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto region_get_source(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto region_get_page(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto region_to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue;
+
+static const auto PROTO_FUNCS = std::array {
+    JSCFunctionListEntry JS_CGETSET_DEF("pageCount", get_page_count, nullptr),
+    JSCFunctionListEntry JS_CGETSET_DEF("names", get_names, nullptr),
+    JSCFunctionListEntry JS_CFUNC_DEF("region", 1, region),
+    JSCFunctionListEntry JS_CFUNC_DEF("page", 1, page),
+    JSCFunctionListEntry JS_CFUNC_DEF("unload", 0, unload),
+    JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
+};
+
+static const auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("load", 2, load),
+};
+
+static const auto REGION_PROTO_FUNCS = std::array {
+    JSCFunctionListEntry JS_CGETSET_DEF("source", region_get_source, nullptr),
+    JSCFunctionListEntry JS_CGETSET_DEF("page", region_get_page, nullptr),
+    JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, region_to_string),
+};
+
+extern const JSClassDef ATLAS = {
+    .class_name = "Atlas",
+    .finalizer = finalizer,
+    .gc_mark = nullptr,
+    .call = nullptr,
+    .exotic = nullptr,
+};
+
+extern const JSClassDef ATLAS_REGION = {
+    .class_name = "AtlasRegion",
+    .finalizer = region_finalizer,
+    .gc_mark = nullptr,
+    .call = nullptr,
+    .exotic = nullptr,
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:Atlas", [](auto js, auto m) -> int {
+        JS_NewClass(JS_GetRuntime(js), js::class_id<&ATLAS>(js), &ATLAS);
+        JS_NewClass(JS_GetRuntime(js), js::class_id<&ATLAS_REGION>(js), &ATLAS_REGION);
+
+        JSValue region_proto = JS_NewObject(js);
+        JS_SetPropertyFunctionList(js, region_proto, REGION_PROTO_FUNCS.data(), int {REGION_PROTO_FUNCS.size()});
+        JS_SetClassProto(js, js::class_id<&ATLAS_REGION>(js), region_proto);
+
+        JSValue proto = JS_NewObject(js);
+        JS_SetPropertyFunctionList(js, proto, PROTO_FUNCS.data(), int {PROTO_FUNCS.size()});
+        JS_SetClassProto(js, js::class_id<&ATLAS>(js), proto);
+
+        JSValue ctor = JS_NewCFunction2(js, constructor, "Atlas", 2, JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
+        JS_SetConstructor(js, ctor, proto);
+
+        JS_SetModuleExport(js, m, "Atlas", JS_DupValue(js, ctor));
+        JS_SetModuleExport(js, m, "default", ctor);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "Atlas");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+static auto from_this(JSContext *js, JSValueConst this_val) -> js::JSResult<AtlasClassData *> {
+    const auto data = static_cast<AtlasClassData *>(JS_GetOpaque(this_val, js::class_id<&ATLAS>(js)));
+    if (data == nullptr) return Unexpected(js::JSError::type_error(js, "Not an instance of Atlas"));
+    return data;
+}
+
+/// Wrap atlas data into Atlas object with default prototype, releasing its pages on failure
+static auto wrap(JSContext *js, AtlasClassData&& data, JSValueConst proto) -> js::Value {
+    auto obj = js::own(js, JS_NewObjectProtoClass(js, proto, js::class_id<&ATLAS>(js)));
+    if (JS_IsException(obj.cget())) {
+        for (const auto handle : data.pages) Engine::get(js).texture_store().release(handle, false);
+        return obj;
+    }
+    auto ptr = owner<AtlasClassData *> {new (std::nothrow) AtlasClassData {std::move(data)}};
+    JS_SetOpaque(obj.cget(), ptr);
+    return obj;
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Atlas.constructor/{}", argc);
+    const auto source = read_atlas_source(js, argc, argv);
+    if (!source) return jsthrow(source.error());
+
+    auto atlas = compose(*source, Engine::get(js).file_store());
+    if (!atlas) return JS_ThrowInternalError(js, "Could not build atlas: %s", atlas.error()->msg().c_str());
+
+    auto proto = JS_GetPropertyStr(js, new_target, "prototype");
+    if (JS_IsException(proto)) return proto;
+    defer(JS_FreeValue(js, proto));
+
+    auto obj = wrap(js, upload(js, *atlas), proto);
+    return JS_DupValue(js, obj.cget());
+}
+
+static auto load(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Atlas.load/{}", argc);
+    auto source = read_atlas_source(js, argc, argv);
+    if (!source) return jsthrow(source.error());
+    auto promise = js::Promise::create(js);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(js);
+
+    auto result = promise->object();
+    e.asset_loader().submit(
+        [&store = e.file_store(), source = std::move(*source)] { return compose(source, store); },
+        [promise = std::move(*promise)](Result<ComposedAtlas>&& atlas) mutable {
+            const auto js = promise.ctx();
+            if (!atlas) {
+                auto message = fmt::format("Could not build atlas: {}", atlas.error()->msg());
+                return promise.reject(js::JSError::plain_error(js, message));
+            }
+            auto proto = js::own(js, JS_GetClassProto(js, js::class_id<&ATLAS>(js)));
+            auto obj = wrap(js, upload(js, *atlas), proto.cget());
+            if (JS_IsException(obj.cget())) {
+                return promise.reject(js::JSError::from_value(js::own(js, JS_GetException(js))));
+            }
+            promise.resolve(obj);
+        }
+    );
+    return result;
+}
+
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void {
+    SPDLOG_TRACE("Finalizing Atlas");
+    auto ptr = owner<AtlasClassData *>(JS_GetOpaque(val, js::class_id<&ATLAS>(rt)));
+    if (!ptr) return;
+    auto& e = Engine::get(rt);
+    for (const auto handle : ptr->pages) e.texture_store().release(handle, false);
+    delete ptr;
+}
+
+static auto region(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Atlas.region/{}", argc);
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    const auto args = js::unpack_args<std::string>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [name] = *args;
+
+    const auto it = (*data)->regions.find(name);
+    if (it == (*data)->regions.end()) return JS_UNDEFINED;
+    const auto& [page, source] = it->second;
+
+    auto obj = JS_NewObjectClass(js, int(js::class_id<&ATLAS_REGION>(js)));
+    if (JS_IsException(obj)) return obj;
+    const auto handle = (*data)->pages[page];
+    // Region keeps its own reference to page
+    (void)Engine::get(js).texture_store().get(handle);
+    auto ptr = owner<RegionClassData *> {new (std::nothrow) RegionClassData {.page = handle, .source = source}};
+    JS_SetOpaque(obj, ptr);
+    return obj;
+}
+
+static auto page(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Atlas.page/{}", argc);
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    const auto args = js::unpack_args<size_t>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [index] = *args;
+    if (index >= (*data)->pages.size()) return JS_ThrowRangeError(js, "Atlas has no page %zu", index);
+
+    const auto handle = (*data)->pages[index];
+    (void)Engine::get(js).texture_store().get(handle);
+    auto obj = texture::wrap(js, handle);
+    return JS_DupValue(js, obj.cget());
+}
+
+static auto unload(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
+    GLINT_TRACE_BINDING("Atlas.unload/{}", argc);
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    // Regions and page textures taken from atlas keep their pages loaded
+    auto& e = Engine::get(js);
+    for (const auto handle : (*data)->pages) e.texture_store().release(handle, false);
+    (*data)->pages.clear();
+    (*data)->regions.clear();
+    return JS_UNDEFINED;
+}
+
+static auto get_page_count(JSContext *js, JSValueConst this_val) -> JSValue {
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    return JS_NewUint32(js, uint32_t((*data)->pages.size()));
+}
+
+static auto get_names(JSContext *js, JSValueConst this_val) -> JSValue {
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    auto array = JS_NewArray(js);
+    if (JS_IsException(array)) return array;
+    auto i = uint32_t {};
+    for (const auto& [name, _] : (*data)->regions) {
+        JS_SetPropertyUint32(js, array, i++, JS_NewStringLen(js, name.data(), name.size()));
+    }
+    return array;
+}
+
+static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
+    const auto data = from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    const auto str = fmt::format("Atlas {{ pages: {}, regions: {} }}", (*data)->pages.size(), (*data)->regions.size());
+    return JS_NewString(js, str.c_str());
+}
+
+static auto region_from_this(JSContext *js, JSValueConst this_val) -> js::JSResult<RegionClassData *> {
+    const auto data = static_cast<RegionClassData *>(JS_GetOpaque(this_val, js::class_id<&ATLAS_REGION>(js)));
+    if (data == nullptr) return Unexpected(js::JSError::type_error(js, "Not an instance of AtlasRegion"));
+    return data;
+}
+
+static auto region_finalizer(JSRuntime *rt, JSValueConst val) -> void {
+    SPDLOG_TRACE("Finalizing AtlasRegion");
+    auto ptr = owner<RegionClassData *>(JS_GetOpaque(val, js::class_id<&ATLAS_REGION>(rt)));
+    if (!ptr) return;
+    Engine::get(rt).texture_store().release(ptr->page, false);
+    delete ptr;
+}
+
+static auto region_get_source(JSContext *js, JSValueConst this_val) -> JSValue {
+    const auto data = region_from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    return math::rectangle::create(js, (*data)->source);
+}
+
+static auto region_get_page(JSContext *js, JSValueConst this_val) -> JSValue {
+    const auto data = region_from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    (void)Engine::get(js).texture_store().get((*data)->page);
+    auto obj = texture::wrap(js, (*data)->page);
+    return JS_DupValue(js, obj.cget());
+}
+
+static auto region_to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
+    const auto data = region_from_this(js, this_val);
+    if (!data) return jsthrow(data.error());
+    const auto str = fmt::format("AtlasRegion {{ source: {} }}", (*data)->source);
+    return JS_NewString(js, str.c_str());
+}
+
+} // namespace glint::plugins::graphics::atlas
@@ -7,6 +7,7 @@
 #include <fmt/format.h>
 #include <raylib.h>
 
+#include <binding_trace.hpp>
 #include <defer.hpp>
 #include <engine.hpp>
 #include <error.hpp>
@@ -21,14 +22,15 @@ auto try_into<Camera2D>(const Value& val) noexcept -> JSResult<Camera2D> {
     auto cam = Camera2D {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto v = obj->at<Vector2>("offset")) cam.offset = *v;
+    if (auto v = obj->at<Vector2>(atoms[Atom::offset])) cam.offset = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<Vector2>("target")) cam.target = *v;
+    if (auto v = obj->at<Vector2>(atoms[Atom::target])) cam.target = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("rotation")) cam.rotation = *v;
+    if (auto v = obj->at<float>(atoms[Atom::rotation])) cam.rotation = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("zoom")) cam.zoom = *v;
+    if (auto v = obj->at<float>(atoms[Atom::zoom])) cam.zoom = *v;
     else return Unexpected(v.error());
 
     return cam;
@@ -106,7 +108,7 @@ auto pointer_from_value(JSContext *js, JSValueConst val) -> Camera2D * {
 }
 
 static auto constructor(JSContext *js, JSValue new_target, int argc, JSValue *argv) -> JSValue {
-    SPDLOG_TRACE("Camera.constructor/{}", argc);
+    GLINT_TRACE_BINDING("Camera.constructor/{}", argc);
     const auto args = js::unpack_args<Vector2, Vector2, float, float>(js, argc, argv);
     if (!args) return js::jsthrow(args.error());
     const auto [offset, target, rotation, zoom] = *args;
@@ -152,18 +154,12 @@ static auto default_camera(JSContext *js, JSValueConst, int, JSValue *) -> JSVal
 
 static auto get_offset(JSContext *js, JSValueConst this_val) -> JSValue {
     const auto cam = pointer_from_value(js, this_val);
-    const auto obj = JS_NewObjectClass(js, js::class_id<&math::vector2::VECTOR2>(js));
-    const auto vec = owner<Vector2 *>(new Vector2 {.x = cam->offset.x, .y = cam->offset.y});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return math::vector2::create(js, cam->offset);
 }
 
 static auto get_target(JSContext *js, JSValueConst this_val) -> JSValue {
     const auto cam = pointer_from_value(js, this_val);
-    const auto obj = JS_NewObjectClass(js, js::class_id<&math::vector2::VECTOR2>(js));
-    const auto vec = owner<Vector2 *>(new Vector2 {.x = cam->target.x, .y = cam->target.y});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return math::vector2::create(js, cam->target);
 }
 
 static auto get_rotation(JSContext *js, JSValueConst this_val) -> JSValue {
@@ -10,6 +10,7 @@
 #include <raylib.h>
 
 #include <defer.hpp>
+#include <engine.hpp>
 #include <error.hpp>
 
 namespace glint::js {
@@ -21,14 +22,15 @@ auto try_into<Color>(const Value& val) noexcept -> JSResult<Color> {
     auto c = Color {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto v = obj->at<unsigned char>("r")) c.r = *v;
+    if (auto v = obj->at<unsigned char>(atoms[Atom::r])) c.r = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<unsigned char>("g")) c.g = *v;
+    if (auto v = obj->at<unsigned char>(atoms[Atom::g])) c.g = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<unsigned char>("b")) c.b = *v;
+    if (auto v = obj->at<unsigned char>(atoms[Atom::b])) c.b = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<unsigned char>("a")) c.a = *v;
+    if (auto v = obj->at<unsigned char>(atoms[Atom::a])) c.a = *v;
     else return Unexpected(v.error());
 
     return c;
@@ -2,6 +2,9 @@
 
 #include <array>
 
+#include <fmt/format.h>
+
+#include <binding_trace.hpp>
 #include <engine.hpp>
 #include <defer.hpp>
 
@@ -35,6 +38,8 @@ auto try_into<FontOptions>(const Value& val) noexcept -> JSResult<FontOptions> t
     else return Unexpected(v.error());
     if (auto v = obj->at<std::optional<std::vector<int>>>("codepoints")) o.codepoints = *v;
     else return Unexpected(v.error());
+    if (auto v = obj->at<std::optional<bool>>("dynamic")) o.dynamic = *v;
+    else return Unexpected(v.error());
 
     return o;
 } catch (std::exception& e) {
@@ -56,10 +61,11 @@ inline auto read_font_options_from_args(not_null<JSContext *> ctx, int argc, JSV
             .name = path,
             .font_size = 32,
             .codepoints = std::nullopt,
+            .dynamic = false,
         };
     } else if (auto args_options = js::unpack_args<FontOptions>(ctx, argc, argv)) {
         auto [opts] = std::move(*args_options);
-        if (opts.name && !opts.path && !opts.font_size && !opts.codepoints) {
+        if (opts.name && !opts.path && !opts.font_size && !opts.codepoints && !opts.dynamic) {
             return FontLoadByName {
                 .name = std::move(*opts.name),
             };
@@ -70,6 +76,7 @@ inline auto read_font_options_from_args(not_null<JSContext *> ctx, int argc, JSV
                 .name = std::move(*opts.name),
                 .font_size = opts.font_size.value_or(32),
                 .codepoints = std::move(opts.codepoints),
+                .dynamic = opts.dynamic.value_or(false),
             };
         } else {
             return Unexpected(js::JSError::type_error(ctx, "Either name or path must be present in options"));
@@ -81,8 +88,18 @@ inline auto read_font_options_from_args(not_null<JSContext *> ctx, int argc, JSV
     return Unexpected(JSError::plain_error(ctx, fmt::format("Unexpected C++ exception: {}", e.what())));
 }
 
+/// Synchronous load from file, also used to reload font evicted from store
+static auto loader(const FontLoadByParams& params, IFileStore& store) -> ResourceStore<FontData>::Loader {
+    return [params = params, &store]() mutable -> FontData {
+        auto codepoints = params.codepoints.transform([](auto& c) { return std::span(c); });
+        if (params.dynamic) return FontData::load_dynamic(params.path, params.font_size, codepoints, store);
+        return FontData::load(params.path, params.font_size, codepoints, store);
+    };
+}
+
 static auto constructor(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
 static auto finalizer(JSRuntime *rt, JSValueConst this_val) -> void;
+static auto load(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
 static auto get_valid(::JSContext *js, ::JSValueConst this_val) -> ::JSValue;
 static auto to_string(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
 
@@ -99,6 +116,10 @@ static const auto PROTO_FUNCS = std::array {
     JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
 };
 
+static const auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("load", 1, load),
+};
+
 auto module(JSContext *js) -> JSModuleDef * {
     auto m = JS_NewCModule(js, "glint:Font", [](auto js, auto m) -> int {
         JS_NewClass(JS_GetRuntime(js), js::class_id<&CLASS>(js), &CLASS);
@@ -108,6 +129,7 @@ auto module(JSContext *js) -> JSModuleDef * {
         JS_SetClassProto(js, js::class_id<&CLASS>(js), proto);
 
         auto ctor = JS_NewCFunction2(js, constructor, "Font", 0, ::JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
         JS_SetConstructor(js, ctor, proto);
 
         JS_SetModuleExport(js, m, "Font", JS_DupValue(js, ctor));
@@ -127,17 +149,13 @@ static auto constructor(JSContext *js, JSValue this_val, int argc, JSValue *argv
     auto& e = Engine::get(js);
 
     const auto handle = std::visit(
-        [&](auto&& arg) -> js::JSResult<int> {
+        [&](auto&& arg) -> js::JSResult<ResourceStore<FontData>::Handle> {
             using T = std::decay_t<decltype(arg)>;
 
             if constexpr (std::is_same_v<T, FontLoadByName>) {
                 return e.font_store().load_by_name(arg.name);
             } else if constexpr (std::is_same_v<T, FontLoadByParams>) {
-                return e.font_store().load(arg.name, [&]() -> FontData {
-                    std::optional<std::span<int>> codepoints {};
-                    if (arg.codepoints) codepoints = std::span(*arg.codepoints);
-                    return FontData::load(arg.path, arg.font_size, codepoints, e.file_store());
-                });
+                return e.font_store().load(arg.name, loader(arg, e.file_store()));
             } else if constexpr (std::is_same_v<T, std::monostate>) {
                 return Unexpected(js::JSError::type_error(js, "Either name or path must be present in options"));
             } else {
@@ -165,6 +183,93 @@ static auto constructor(JSContext *js, JSValue this_val, int argc, JSValue *argv
     return obj;
 }
 
+/// Resolve promise with Font wrapping already referenced handle
+static auto settle(js::Promise& promise, ResourceStore<FontData>::Handle handle) -> void {
+    const auto js = promise.ctx();
+    auto obj = js::own(js, JS_NewObjectClass(js, int(js::class_id<&CLASS>(js))));
+    if (JS_IsException(obj.cget())) {
+        Engine::get(js).font_store().release(handle);
+        return promise.reject(js::JSError::from_value(js::own(js, JS_GetException(js))));
+    }
+    auto data = owner<FontClassData *>(new FontClassData {.handle = handle});
+    JS_SetOpaque(obj.cget(), data);
+    promise.resolve(obj);
+}
+
+static auto load(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Font.load/{}", argc);
+    auto opts = read_font_options_from_args(js, argc, argv);
+    if (!opts) return jsthrow(opts.error());
+    auto promise = js::Promise::create(js);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(js);
+
+    if (auto by_name = std::get_if<FontLoadByName>(&*opts)) {
+        const auto handle = e.font_store().load_by_name(by_name->name);
+        if (handle == 0) {
+            auto message = fmt::format("No font named {}", by_name->name);
+            promise->reject(js::JSError::plain_error(js, message));
+        } else {
+            settle(*promise, handle);
+        }
+        return promise->object();
+    }
+
+    auto params = std::get_if<FontLoadByParams>(&*opts);
+    if (params == nullptr) {
+        return jsthrow(js::JSError::type_error(js, "Either name or path must be present in options"));
+    }
+
+    if (const auto handle = e.font_store().load_by_name(params->name); handle != 0) {
+        settle(*promise, handle);
+        return promise->object();
+    }
+
+    auto result = promise->object();
+    if (params->dynamic) {
+        // Glyphs are rasterized on demand, so only font file is read on worker
+        e.asset_loader().submit(
+            [&store = e.file_store(), path = params->path]() { return store.map(path); },
+            [promise = std::move(*promise), params = std::move(*params)](Result<MappedBuffer>&& buf) mutable {
+                if (!buf) {
+                    auto message = fmt::format("Could not load font {}: {}", params.path.string(), buf.error()->msg());
+                    return promise.reject(js::JSError::plain_error(promise.ctx(), message));
+                }
+                auto& e = Engine::get(promise.ctx());
+                const auto upload = [&]() -> FontData {
+                    auto codepoints = params.codepoints.transform([](auto& c) { return std::span(c); });
+                    return FontData::from_memory_dynamic(params.path, std::move(*buf), params.font_size, codepoints);
+                };
+                const auto handle = e.font_store().load(params.name, upload, loader(params, e.file_store()));
+                settle(promise, handle);
+            }
+        );
+        return result;
+    }
+
+    e.asset_loader().submit(
+        // Worker gets its own copy of options, codepoints must outlive decoding
+        [&store = e.file_store(), params = *params]() mutable {
+            auto codepoints = params.codepoints.transform([](auto& c) { return std::span(c); });
+            return FontData::decode(params.path, params.font_size, codepoints, store);
+        },
+        [promise = std::move(*promise), params = std::move(*params)](Result<FontData::Decoded>&& decoded) mutable {
+            if (!decoded) {
+                auto message = fmt::format("Could not load font {}: {}", params.path.string(), decoded.error()->msg());
+                return promise.reject(js::JSError::plain_error(promise.ctx(), message));
+            }
+            auto& e = Engine::get(promise.ctx());
+            const auto upload = [&]() -> FontData {
+                auto codepoints = params.codepoints.transform([](auto& c) { return std::span(c); });
+                return FontData::from_decoded(params.path, std::move(*decoded), params.font_size, codepoints);
+            };
+            const auto handle = e.font_store().load(params.name, upload, loader(params, e.file_store()));
+            settle(promise, handle);
+        }
+    );
+    return result;
+}
+
 static auto finalizer(JSRuntime *rt, JSValueConst this_val) -> void {
     auto ptr = owner<FontClassData *>(JS_GetOpaque(this_val, js::class_id<&CLASS>(rt)));
     if (!ptr) {
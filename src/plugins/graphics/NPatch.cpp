@@ -7,6 +7,7 @@
 #include <raylib.h>
 
 #include <defer.hpp>
+#include <engine.hpp>
 #include <plugins/math.hpp>
 
 namespace glint::js {
@@ -18,18 +19,19 @@ auto try_into<NPatchInfo>(const Value& val) noexcept -> JSResult<NPatchInfo> {
     auto np = NPatchInfo {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto v = obj->at<Rectangle>("source")) np.source = *v;
+    if (auto v = obj->at<Rectangle>(atoms[Atom::source])) np.source = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<int>("left")) np.left = *v;
+    if (auto v = obj->at<int>(atoms[Atom::left])) np.left = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<int>("top")) np.top = *v;
+    if (auto v = obj->at<int>(atoms[Atom::top])) np.top = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<int>("right")) np.right = *v;
+    if (auto v = obj->at<int>(atoms[Atom::right])) np.right = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<int>("bottom")) np.bottom = *v;
+    if (auto v = obj->at<int>(atoms[Atom::bottom])) np.bottom = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<int>("layout")) np.layout = *v;
+    if (auto v = obj->at<int>(atoms[Atom::layout])) np.layout = *v;
     else return Unexpected(v.error());
 
     return np;
@@ -139,15 +141,7 @@ static auto get_source(JSContext *js, JSValueConst this_val) -> JSValue {
     if (!data) return jsthrow(data.error());
     const auto npatch = (*data)->npatch;
 
-    auto obj = JS_NewObjectClass(js, js::class_id<&math::rectangle::RECTANGLE>(js));
-    auto rec = owner<Rectangle *>(new Rectangle {
-        .x = npatch.source.x,
-        .y = npatch.source.y,
-        .width = npatch.source.width,
-        .height = npatch.source.height,
-    });
-    JS_SetOpaque(obj, rec);
-    return obj;
+    return math::rectangle::create(js, npatch.source);
 }
 
 static auto get_left(JSContext *js, JSValueConst this_val) -> JSValue {
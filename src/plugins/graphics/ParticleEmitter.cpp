@@ -0,0 +1,496 @@
+#include <plugins/graphics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gsl/gsl>
+#include <span>
+
+#include <fmt/format.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <defer.hpp>
+#include <engine.hpp>
+#include <plugins/math.hpp>
+#include <simd.hpp>
+
+namespace glint::js {
+
+/// Number or `[min, max]` pair
+template<>
+auto try_into<plugins::graphics::particle_emitter::Range>(const Value& val) noexcept
+    -> JSResult<plugins::graphics::particle_emitter::Range> {
+    using plugins::graphics::particle_emitter::Range;
+    if (JS_IsNumber(val.cget())) {
+        const auto v = try_into<float>(val);
+        if (!v) return Unexpected(v.error());
+        return Range {.min = *v, .max = *v};
+    }
+
+    const auto bounds = try_into<std::vector<float>>(val);
+    if (!bounds || bounds->size() != 2) {
+        return Unexpected(
+            JSError::type_error(
+                val.ctx(), fmt::format("Value of type `{}` is not a number or [min, max] pair", display_type(val))
+            )
+        );
+    }
+    const auto [min, max] = std::array {(*bounds)[0], (*bounds)[1]};
+    if (min > max) {
+        return Unexpected(
+            JSError::range_error(val.ctx(), fmt::format("Range minimum {} is above maximum {}", min, max))
+        );
+    }
+    return Range {.min = min, .max = max};
+}
+
+} // namespace glint::js
+
+namespace glint::plugins::graphics::particle_emitter {
+
+using namespace gsl;
+
+auto ParticleEmitterClassData::from_value(const Value& val) -> JSResult<ParticleEmitterClassData *> {
+    const auto data =
+        static_cast<ParticleEmitterClassData *>(JS_GetOpaque(val.cget(), class_id<&PARTICLE_EMITTER>(val.ctx())));
+    if (data == nullptr) return Unexpected(JSError::type_error(val.ctx(), "Not an instance of ParticleEmitter"));
+    return data;
+}
+
+static auto pick(std::minstd_rand& random, Range range) noexcept -> float {
+    if (range.min == range.max) return range.min;
+    return std::uniform_real_distribution<float>(range.min, range.max)(random);
+}
+
+/// Spawn up to `count` particles at emitter position, particles over capacity are dropped
+static auto spawn(ParticleEmitterClassData& data, size_t count) noexcept -> void {
+    auto& p = data.particles;
+    const auto& config = data.config;
+    count = std::min(count, data.capacity - p.count);
+
+    for (size_t n = 0; n < count; n++) {
+        const auto i = p.count++;
+        const auto angle = pick(data.random, config.angle) * DEG2RAD;
+        const auto speed = pick(data.random, config.speed);
+        p.positions[i * 2] = data.position.x;
+        p.positions[i * 2 + 1] = data.position.y;
+        p.velocities[i * 2] = std::cos(angle) * speed;
+        p.velocities[i * 2 + 1] = std::sin(angle) * speed;
+        p.ages[i] = 0.0f;
+        p.lifetimes[i] = pick(data.random, config.lifetime);
+        p.rotations[i] = 0.0f;
+        p.spins[i] = pick(data.random, config.spin) * DEG2RAD;
+    }
+}
+
+/// Drop particles that outlived their lifetime, keeping order of the rest
+static auto cull(Particles& p) noexcept -> void {
+    auto alive = size_t {};
+    for (size_t i = 0; i < p.count; i++) {
+        if (p.ages[i] >= p.lifetimes[i]) continue;
+        if (alive != i) {
+            p.positions[alive * 2] = p.positions[i * 2];
+            p.positions[alive * 2 + 1] = p.positions[i * 2 + 1];
+            p.velocities[alive * 2] = p.velocities[i * 2];
+            p.velocities[alive * 2 + 1] = p.velocities[i * 2 + 1];
+            p.ages[alive] = p.ages[i];
+            p.lifetimes[alive] = p.lifetimes[i];
+            p.rotations[alive] = p.rotations[i];
+            p.spins[alive] = p.spins[i];
+        }
+        alive++;
+    }
+    p.count = alive;
+}
+
+/// Age, cull and move particles, then emit new ones for elapsed time
+static auto step(ParticleEmitterClassData& data, float dt) noexcept -> void {
+    auto& p = data.particles;
+    const auto& config = data.config;
+
+    // Loops over single arrays are vectorized by compiler, xy pairs go through SIMD kernels
+    for (size_t i = 0; i < p.count; i++) p.ages[i] += dt;
+    cull(p);
+
+    const auto positions = std::span(p.positions).first(p.count * 2);
+    const auto velocities = std::span(p.velocities).first(p.count * 2);
+    const auto damping = std::max(0.0f, 1.0f - config.drag * dt);
+    if (damping != 1.0f) simd::scale(velocities, Vector2 {.x = damping, .y = damping});
+    if (config.gravity.x != 0.0f || config.gravity.y != 0.0f) {
+        simd::add(velocities, Vector2 {.x = config.gravity.x * dt, .y = config.gravity.y * dt});
+    }
+    simd::mul_add(positions, velocities, dt);
+    for (size_t i = 0; i < p.count; i++) p.rotations[i] += p.spins[i] * dt;
+
+    // Particles over capacity would be dropped anyway, clamping keeps conversion to size_t in range
+    data.pending = std::clamp(data.pending + data.rate * dt, 0.0f, float(data.capacity));
+    const auto whole = std::floor(data.pending);
+    data.pending -= whole;
+    spawn(data, size_t(whole));
+}
+
+static auto mix(unsigned char from, unsigned char to, float t) noexcept -> unsigned char {
+    return static_cast<unsigned char>(float(from) + (float(to) - float(from)) * t);
+}
+
+/// Push live particles into the active rlgl batch as textured quads rotated around their center.
+/// Size and color go from start to end values over lifetime of particle
+static auto submit(const ParticleEmitterClassData& data, unsigned int texture_id, Rectangle uv, float aspect) noexcept
+    -> void {
+    const auto& p = data.particles;
+    const auto& config = data.config;
+
+    for (size_t first = 0; first < p.count; first += sprite_batch::CHUNK_SIZE) {
+        const auto last = std::min(p.count, first + sprite_batch::CHUNK_SIZE);
+
+        rlCheckRenderBatchLimit(int((last - first) * 4));
+        rlSetTexture(texture_id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (size_t i = first; i < last; i++) {
+            // Particles of zero lifetime live until next update and look like at the end of their life
+            const auto t = p.lifetimes[i] > 0.0f ? std::min(p.ages[i] / p.lifetimes[i], 1.0f) : 1.0f;
+            const auto size = config.start_size + (config.end_size - config.start_size) * t;
+            const auto hw = size * 0.5f;
+            const auto hh = size * aspect * 0.5f;
+            const auto x = p.positions[i * 2];
+            const auto y = p.positions[i * 2 + 1];
+            const auto c = std::cos(p.rotations[i]);
+            const auto s = std::sin(p.rotations[i]);
+
+            const auto corner = [&](float dx, float dy) -> Vector2 {
+                return Vector2 {.x = x + dx * c - dy * s, .y = y + dx * s + dy * c};
+            };
+            const auto tl = corner(-hw, -hh);
+            const auto bl = corner(-hw, hh);
+            const auto br = corner(hw, hh);
+            const auto tr = corner(hw, -hh);
+
+            const auto& from = config.start_color;
+            const auto& to = config.end_color;
+            rlColor4ub(mix(from.r, to.r, t), mix(from.g, to.g, t), mix(from.b, to.b, t), mix(from.a, to.a, t));
+
+            rlTexCoord2f(uv.x, uv.y);
+            rlVertex2f(tl.x, tl.y);
+            rlTexCoord2f(uv.x, uv.y + uv.height);
+            rlVertex2f(bl.x, bl.y);
+            rlTexCoord2f(uv.x + uv.width, uv.y + uv.height);
+            rlVertex2f(br.x, br.y);
+            rlTexCoord2f(uv.x + uv.width, uv.y);
+            rlVertex2f(tr.x, tr.y);
+        }
+
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue;
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto update(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto emit(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto clear(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto get_position(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_rate(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_count(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_capacity(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto set_position(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue;
+static auto set_rate(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue;
+static auto to_string(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+
+static const auto PROTO_FUNCS = std::array {
+    JSCFunctionListEntry JS_CGETSET_DEF("position", get_position, set_position),
+    JSCFunctionListEntry JS_CGETSET_DEF("rate", get_rate, set_rate),
+    JSCFunctionListEntry JS_CGETSET_DEF("count", get_count, nullptr),
+    JSCFunctionListEntry JS_CGETSET_DEF("capacity", get_capacity, nullptr),
+    JSCFunctionListEntry JS_CFUNC_DEF("update", 1, update),
+    JSCFunctionListEntry JS_CFUNC_DEF("emit", 1, emit),
+    JSCFunctionListEntry JS_CFUNC_DEF("clear", 0, clear),
+    JSCFunctionListEntry JS_CFUNC_DEF("draw", 0, draw),
+    JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
+};
+
+extern const JSClassDef PARTICLE_EMITTER = {
+    .class_name = "ParticleEmitter",
+    .finalizer = finalizer,
+    .gc_mark = nullptr,
+    .call = nullptr,
+    .exotic = nullptr,
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:ParticleEmitter", [](auto js, auto m) -> int {
+        JS_NewClass(JS_GetRuntime(js), js::class_id<&PARTICLE_EMITTER>(js), &PARTICLE_EMITTER);
+
+        JSValue proto = JS_NewObject(js);
+        JS_SetPropertyFunctionList(js, proto, PROTO_FUNCS.data(), int {PROTO_FUNCS.size()});
+        JS_SetClassProto(js, js::class_id<&PARTICLE_EMITTER>(js), proto);
+
+        JSValue ctor = JS_NewCFunction2(js, constructor, "ParticleEmitter", 1, JS_CFUNC_constructor, 0);
+        JS_SetConstructor(js, ctor, proto);
+
+        JS_SetModuleExport(js, m, "ParticleEmitter", JS_DupValue(js, ctor));
+        JS_SetModuleExport(js, m, "default", ctor);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "ParticleEmitter");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+/// Emitter settings of constructor options, with defaults for missing ones
+static auto read_config(const js::Object& obj) -> JSResult<EmitterConfig> {
+    const auto lifetime = obj.at<std::optional<Range>>("lifetime");
+    if (!lifetime) return Unexpected(lifetime.error());
+    const auto speed = obj.at<std::optional<Range>>("speed");
+    if (!speed) return Unexpected(speed.error());
+    const auto angle = obj.at<std::optional<Range>>("angle");
+    if (!angle) return Unexpected(angle.error());
+    const auto spin = obj.at<std::optional<Range>>("spin");
+    if (!spin) return Unexpected(spin.error());
+    const auto start_size = obj.at<std::optional<float>>("startSize");
+    if (!start_size) return Unexpected(start_size.error());
+    const auto end_size = obj.at<std::optional<float>>("endSize");
+    if (!end_size) return Unexpected(end_size.error());
+    const auto start_color = obj.at<std::optional<Color>>("startColor");
+    if (!start_color) return Unexpected(start_color.error());
+    const auto end_color = obj.at<std::optional<Color>>("endColor");
+    if (!end_color) return Unexpected(end_color.error());
+    const auto gravity = obj.at<std::optional<Vector2>>("gravity");
+    if (!gravity) return Unexpected(gravity.error());
+    const auto drag = obj.at<std::optional<float>>("drag");
+    if (!drag) return Unexpected(drag.error());
+
+    // End values default to start ones, so that particles keep their look unless asked otherwise
+    return EmitterConfig {
+        .lifetime = lifetime->value_or(Range {.min = 1.0f, .max = 1.0f}),
+        .speed = speed->value_or(Range {.min = 100.0f, .max = 100.0f}),
+        .angle = angle->value_or(Range {.min = 0.0f, .max = 360.0f}),
+        .spin = spin->value_or(Range {.min = 0.0f, .max = 0.0f}),
+        .start_size = start_size->value_or(8.0f),
+        .end_size = end_size->value_or(start_size->value_or(8.0f)),
+        .start_color = start_color->value_or(WHITE),
+        .end_color = end_color->value_or(start_color->value_or(WHITE)),
+        .gravity = gravity->value_or(Vector2 {.x = 0.0f, .y = 0.0f}),
+        .drag = drag->value_or(0.0f),
+    };
+}
+
+static auto is_valid_rate(float rate) noexcept -> bool {
+    return std::isfinite(rate) && rate >= 0.0f;
+}
+
+static auto throw_invalid_rate(JSContext *js, float rate) -> JSValue {
+    return JS_ThrowRangeError(js, "Emission rate must be finite and not negative, got %f", double(rate));
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("ParticleEmitter.constructor/{}", argc);
+    const auto args = js::unpack_args<js::Value>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto obj = js::Object::from_value(std::get<0>(*args));
+    if (!obj) return jsthrow(obj.error());
+    const auto& atoms = Engine::get(js).atoms();
+
+    const auto capacity = obj->at<int>("capacity");
+    if (!capacity) return jsthrow(capacity.error());
+    if (*capacity <= 0) return JS_ThrowRangeError(js, "Particle capacity must be positive, got %d", *capacity);
+    const auto config = read_config(*obj);
+    if (!config) return jsthrow(config.error());
+    const auto position = obj->at<std::optional<Vector2>>(atoms[Atom::position]);
+    if (!position) return jsthrow(position.error());
+    const auto source = obj->at<std::optional<Rectangle>>(atoms[Atom::source]);
+    if (!source) return jsthrow(source.error());
+    const auto rate = obj->at<std::optional<float>>("rate");
+    if (!rate) return jsthrow(rate.error());
+    if (*rate && !is_valid_rate(**rate)) return throw_invalid_rate(js, **rate);
+    const auto seed = obj->at<std::optional<uint32_t>>("seed");
+    if (!seed) return jsthrow(seed.error());
+    const auto texture = obj->at<js::Value>("texture");
+    if (!texture) return jsthrow(texture.error());
+
+    auto texture_handle = ResourceStore<TextureData>::Handle {};
+    if (!JS_IsUndefined(texture->cget())) {
+        const auto texture_id = js::class_id<&texture::TEXTURE>(js);
+        const auto texture_data = static_cast<texture::TextureClassData *>(JS_GetOpaque(texture->cget(), texture_id));
+        if (texture_data == nullptr) return JS_ThrowTypeError(js, "Expected Texture object");
+        texture_handle = texture_data->handle;
+    }
+
+    auto proto = JS_GetPropertyStr(js, new_target, "prototype");
+    if (JS_IsException(proto)) {
+        return proto;
+    }
+    defer(JS_FreeValue(js, proto));
+
+    auto obj_val = JS_NewObjectProtoClass(js, proto, js::class_id<&PARTICLE_EMITTER>(js));
+    if (JS_IsException(obj_val)) {
+        return obj_val;
+    }
+
+    try {
+        auto data = std::make_unique<ParticleEmitterClassData>(ParticleEmitterClassData {
+            .texture = texture_handle,
+            .source = *source,
+            .config = *config,
+            .position = position->value_or(Vector2 {.x = 0.0f, .y = 0.0f}),
+            .rate = rate->value_or(0.0f),
+            .capacity = size_t(*capacity),
+            .random = std::minstd_rand(seed->value_or(std::random_device {}())),
+        });
+        // Particle arrays are allocated once, so that updates never allocate
+        auto& p = data->particles;
+        p.positions.resize(data->capacity * 2);
+        p.velocities.resize(data->capacity * 2);
+        p.ages.resize(data->capacity);
+        p.lifetimes.resize(data->capacity);
+        p.rotations.resize(data->capacity);
+        p.spins.resize(data->capacity);
+
+        // Emitter keeps its own reference, so texture outlives the JS Texture object if needed
+        if (texture_handle != 0) (void)Engine::get(js).texture_store().get(texture_handle);
+        JS_SetOpaque(obj_val, owner<ParticleEmitterClassData *>(data.release()));
+    } catch (std::exception& e) {
+        JS_FreeValue(js, obj_val);
+        return JS_ThrowInternalError(js, "Could not create ParticleEmitter: %s", e.what());
+    }
+    return obj_val;
+}
+
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void {
+    SPDLOG_TRACE("Finalizing ParticleEmitter");
+    auto ptr = owner<ParticleEmitterClassData *>(JS_GetOpaque(val, js::class_id<&PARTICLE_EMITTER>(rt)));
+    if (ptr == nullptr) {
+        SPDLOG_WARN("Could not free ParticleEmitter because opaque is null");
+        return;
+    }
+    if (ptr->texture != 0) Engine::get(rt).texture_store().release(ptr->texture);
+    delete ptr;
+}
+
+static auto update(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("ParticleEmitter.update/{}", argc);
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto args = js::unpack_args<float>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [dt] = *args;
+    if (!std::isfinite(dt) || dt < 0.0f) {
+        return JS_ThrowRangeError(js, "Time step must be finite and not negative, got %f", double(dt));
+    }
+
+    step(**data, dt);
+    return JS_DupValue(js, this_val);
+}
+
+static auto emit(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("ParticleEmitter.emit/{}", argc);
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto args = js::unpack_args<int>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [count] = *args;
+    if (count < 0) return JS_ThrowRangeError(js, "Particle count must not be negative, got %d", count);
+
+    spawn(**data, size_t(count));
+    return JS_DupValue(js, this_val);
+}
+
+static auto clear(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
+    GLINT_TRACE_BINDING("ParticleEmitter.clear/{}", argc);
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    (*data)->particles.count = 0;
+    (*data)->pending = 0;
+    return JS_DupValue(js, this_val);
+}
+
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
+    GLINT_TRACE_BINDING("ParticleEmitter.draw/{}", argc);
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    if (!IsWindowReady() || (*data)->particles.count == 0) return JS_DupValue(js, this_val);
+
+    // Particles without texture sample white texel of rlgl default texture
+    if ((*data)->texture == 0) {
+        GLINT_TRACE_BINDING("ParticleEmitter submit({} particles)", (*data)->particles.count);
+        submit(**data, rlGetTextureIdDefault(), Rectangle {0.0f, 0.0f, 1.0f, 1.0f}, 1.0f);
+        return JS_DupValue(js, this_val);
+    }
+
+    // Source is resolved on every draw, since texture can be reloaded with different size
+    const ::Texture& texture = Engine::get(js).texture_store().borrow((*data)->texture);
+    const auto width = float(texture.width);
+    const auto height = float(texture.height);
+    const auto source = (*data)->source.value_or(Rectangle {0.0f, 0.0f, width, height});
+    const auto uv = Rectangle {source.x / width, source.y / height, source.width / width, source.height / height};
+    const auto aspect = source.width != 0.0f ? std::abs(source.height / source.width) : 1.0f;
+    GLINT_TRACE_BINDING("ParticleEmitter submit({}, {} particles)", texture, (*data)->particles.count);
+    submit(**data, texture.id, uv, aspect);
+    return JS_DupValue(js, this_val);
+}
+
+static auto get_position(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return math::vector2::create(js, (*data)->position);
+}
+
+static auto get_rate(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewFloat64(js, (*data)->rate);
+}
+
+static auto get_count(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewInt64(js, int64_t((*data)->particles.count));
+}
+
+static auto get_capacity(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewInt64(js, int64_t((*data)->capacity));
+}
+
+static auto set_position(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto position = js::try_into<Vector2>(borrow(js, val));
+    if (!position) return jsthrow(position.error());
+    (*data)->position = *position;
+    return JS_UNDEFINED;
+}
+
+static auto set_rate(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto rate = js::try_into<float>(borrow(js, val));
+    if (!rate) return jsthrow(rate.error());
+    if (!is_valid_rate(*rate)) return throw_invalid_rate(js, *rate);
+    (*data)->rate = *rate;
+    return JS_UNDEFINED;
+}
+
+static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
+    auto data = ParticleEmitterClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto str = fmt::format(
+        "ParticleEmitter {{ count: {}, capacity: {}, rate: {} }}",
+        (*data)->particles.count,
+        (*data)->capacity,
+        (*data)->rate
+    );
+    return JS_NewStringLen(js, str.data(), str.size());
+}
+
+} // namespace glint::plugins::graphics::particle_emitter
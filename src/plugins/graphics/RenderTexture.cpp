@@ -5,6 +5,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
+
 namespace glint::js {
 
 template<>
@@ -71,7 +73,7 @@ auto module(JSContext *js) -> JSModuleDef * {
 }
 
 static auto constructor(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("RenderTexture.constructor/{}", argc);
+    GLINT_TRACE_BINDING("RenderTexture.constructor/{}", argc);
     auto args = js::unpack_args<int, int>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     auto [width, height] = *args;
@@ -87,7 +89,7 @@ static auto constructor(JSContext *js, JSValueConst this_val, int argc, JSValueC
         return obj;
     }
 
-    auto texture = LoadRenderTexture(width, height);
+    auto texture = IsWindowReady() ? LoadRenderTexture(width, height) : ::RenderTexture {};
     if (IsRenderTextureValid(texture)) {
         return JS_ThrowInternalError(js, "Could not create RenderTexture");
     }
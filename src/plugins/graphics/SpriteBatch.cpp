@@ -0,0 +1,216 @@
+#include <plugins/graphics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gsl/gsl>
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <defer.hpp>
+#include <engine.hpp>
+
+namespace glint::plugins::graphics::sprite_batch {
+
+using namespace gsl;
+
+auto SpriteBatchClassData::from_value(const Value& val) -> JSResult<SpriteBatchClassData *> {
+    const auto data =
+        static_cast<SpriteBatchClassData *>(JS_GetOpaque(val.cget(), class_id<&SPRITE_BATCH>(val.ctx())));
+    if (data == nullptr) return Unexpected(JSError::type_error(val.ctx(), "Not an instance of SpriteBatch"));
+    return data;
+}
+
+static auto channel(float value) noexcept -> unsigned char {
+    return static_cast<unsigned char>(std::clamp(value, 0.0f, 255.0f));
+}
+
+/// Push sprites into the active rlgl batch as textured quads.
+/// Quads are rotated around their center, which is placed at record position.
+static auto submit(const ::Texture& texture, std::span<const float> records, size_t count) noexcept -> void {
+    const auto tex_width = static_cast<float>(texture.width);
+    const auto tex_height = static_cast<float>(texture.height);
+
+    for (size_t first = 0; first < count; first += CHUNK_SIZE) {
+        const auto last = std::min(count, first + CHUNK_SIZE);
+
+        rlCheckRenderBatchLimit(int((last - first) * 4));
+        rlSetTexture(texture.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (size_t i = first; i < last; i++) {
+            const auto r = records.subspan(i * STRIDE, STRIDE);
+            const auto x = r[0];
+            const auto y = r[1];
+            const auto sx = r[2];
+            const auto sy = r[3];
+            const auto sw = r[4];
+            const auto sh = r[5];
+            const auto rotation = r[6];
+            const auto kx = r[7];
+            const auto ky = r[8];
+
+            const auto hw = std::abs(sw) * kx * 0.5f;
+            const auto hh = std::abs(sh) * ky * 0.5f;
+            const auto angle = rotation * DEG2RAD;
+            const auto c = std::cos(angle);
+            const auto s = std::sin(angle);
+
+            const auto corner = [&](float dx, float dy) -> Vector2 {
+                return Vector2 {.x = x + dx * c - dy * s, .y = y + dx * s + dy * c};
+            };
+            const auto tl = corner(-hw, -hh);
+            const auto bl = corner(-hw, hh);
+            const auto br = corner(hw, hh);
+            const auto tr = corner(hw, -hh);
+
+            const auto u0 = sx / tex_width;
+            const auto v0 = sy / tex_height;
+            const auto u1 = (sx + sw) / tex_width;
+            const auto v1 = (sy + sh) / tex_height;
+
+            rlColor4ub(channel(r[9]), channel(r[10]), channel(r[11]), channel(r[12]));
+
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(tl.x, tl.y);
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(bl.x, bl.y);
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(br.x, br.y);
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(tr.x, tr.y);
+        }
+
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue;
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto to_string(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+
+static const auto PROTO_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("draw", 1, draw),
+    JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
+};
+
+static const auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_PROP_INT32_DEF("STRIDE", int {STRIDE}, 0),
+};
+
+extern const JSClassDef SPRITE_BATCH = {
+    .class_name = "SpriteBatch",
+    .finalizer = finalizer,
+    .gc_mark = nullptr,
+    .call = nullptr,
+    .exotic = nullptr,
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:SpriteBatch", [](auto js, auto m) -> int {
+        JS_NewClass(JS_GetRuntime(js), js::class_id<&SPRITE_BATCH>(js), &SPRITE_BATCH);
+
+        JSValue proto = JS_NewObject(js);
+        JS_SetPropertyFunctionList(js, proto, PROTO_FUNCS.data(), int {PROTO_FUNCS.size()});
+        JS_SetClassProto(js, js::class_id<&SPRITE_BATCH>(js), proto);
+
+        JSValue ctor = JS_NewCFunction2(js, constructor, "SpriteBatch", 1, JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
+        JS_SetConstructor(js, ctor, proto);
+
+        JS_SetModuleExport(js, m, "default", ctor);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("SpriteBatch.constructor/{}", argc);
+    if (argc < 1) return JS_ThrowRangeError(js, "Expected 1 argument, got %d", argc);
+
+    const auto texture_id = js::class_id<&texture::TEXTURE>(js);
+    const auto texture = static_cast<texture::TextureClassData *>(JS_GetOpaque(argv[0], texture_id));
+    if (texture == nullptr) return JS_ThrowTypeError(js, "Expected Texture object");
+
+    auto proto = JS_GetPropertyStr(js, new_target, "prototype");
+    if (JS_IsException(proto)) {
+        return proto;
+    }
+    defer(JS_FreeValue(js, proto));
+
+    auto obj = JS_NewObjectProtoClass(js, proto, js::class_id<&SPRITE_BATCH>(js));
+    if (JS_HasException(js)) {
+        JS_FreeValue(js, obj);
+        return JS_GetException(js);
+    }
+
+    // Batch keeps its own reference, so texture outlives the JS Texture object if needed
+    auto& e = Engine::get(js);
+    (void)e.texture_store().get(texture->handle);
+
+    auto data = owner<SpriteBatchClassData *>(new SpriteBatchClassData {.texture = texture->handle});
+    JS_SetOpaque(obj, data);
+    return obj;
+}
+
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void {
+    SPDLOG_TRACE("Finalizing SpriteBatch");
+    auto ptr = owner<SpriteBatchClassData *>(JS_GetOpaque(val, js::class_id<&SPRITE_BATCH>(rt)));
+    if (ptr == nullptr) {
+        SPDLOG_WARN("Could not free SpriteBatch because opaque is null");
+        return;
+    }
+    auto& e = Engine::get(rt);
+    e.texture_store().release(ptr->texture);
+    delete ptr;
+}
+
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("SpriteBatch.draw/{}", argc);
+    auto data = SpriteBatchClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    if (argc < 1) return JS_ThrowRangeError(js, "Expected at least 1 argument, got %d", argc);
+
+    // Records are borrowed from Float32Array without copying
+    auto records = js::try_into<std::span<const float>>(borrow(js, argv[0]));
+    if (!records) return jsthrow(records.error());
+
+    auto count = records->size() / STRIDE;
+    if (argc >= 2 && !JS_IsUndefined(argv[1])) {
+        auto requested = js::try_into<int>(borrow(js, argv[1]));
+        if (!requested) return jsthrow(requested.error());
+        if (*requested < 0 || size_t(*requested) > count) {
+            return JS_ThrowRangeError(js, "Sprite count %d is out of range [0, %zu]", *requested, count);
+        }
+        count = size_t(*requested);
+    }
+
+    if (!IsWindowReady()) return JS_DupValue(js, this_val);
+
+    auto& e = Engine::get(js);
+    const auto& texture = e.texture_store().borrow((*data)->texture);
+    GLINT_TRACE_BINDING("SpriteBatch submit({}, {} sprites)", texture, count);
+    submit(texture, *records, count);
+
+    return JS_DupValue(js, this_val);
+}
+
+static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
+    auto data = SpriteBatchClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    auto& e = Engine::get(js);
+    const auto str = fmt::format("SpriteBatch {{ texture: {} }}", e.texture_store().borrow((*data)->texture));
+    return JS_NewStringLen(js, str.data(), str.size());
+}
+
+} // namespace glint::plugins::graphics::sprite_batch
@@ -0,0 +1,372 @@
+#include <plugins/graphics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <gsl/gsl>
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <defer.hpp>
+#include <engine.hpp>
+#include <plugins/math.hpp>
+
+namespace glint::plugins::graphics::text_layout {
+
+using namespace gsl;
+
+auto TextLayoutClassData::from_value(const Value& val) -> JSResult<TextLayoutClassData *> {
+    const auto data = static_cast<TextLayoutClassData *>(JS_GetOpaque(val.cget(), class_id<&TEXT_LAYOUT>(val.ctx())));
+    if (data == nullptr) return Unexpected(JSError::type_error(val.ctx(), "Not an instance of TextLayout"));
+    return data;
+}
+
+static auto font_of(JSContext *js, const TextLayoutClassData& data) -> ::Font {
+    if (data.font == 0) return GetFontDefault();
+    return Engine::get(js).font_store().borrow(data.font);
+}
+
+/// Place glyph quads the same way as DrawTextEx does, but only once per text change
+static auto layout(TextLayoutClassData& data, const ::Font& font) -> void {
+    data.quads.clear();
+    data.size = {};
+    data.glyphs = font.glyphs;
+    data.dirty = false;
+    if (font.glyphs == nullptr || font.recs == nullptr || font.baseSize == 0) return;
+
+    const auto scale = data.font_size / float(font.baseSize);
+    const auto padding = float(font.glyphPadding);
+    auto x = 0.0f;
+    auto y = 0.0f;
+    auto width = 0.0f;
+
+    const auto end_line = [&]() {
+        // Spacing is added after every glyph, so last one of the line is taken back
+        if (x > 0) width = std::max(width, x - data.spacing);
+        x = 0;
+    };
+
+    for (size_t i = 0; i < data.text.size();) {
+        auto size = 0;
+        const auto codepoint = GetCodepointNext(data.text.c_str() + i, &size);
+        i += size_t(std::max(size, 1));
+
+        if (codepoint == '\n') {
+            end_line();
+            y += data.font_size + LINE_SPACING;
+            continue;
+        }
+
+        const auto index = GetGlyphIndex(font, codepoint);
+        const auto& glyph = font.glyphs[index];
+        const auto& rec = font.recs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            data.quads.push_back({
+                .source = {
+                    .x = rec.x - padding,
+                    .y = rec.y - padding,
+                    .width = rec.width + 2 * padding,
+                    .height = rec.height + 2 * padding,
+                },
+                .dest = {
+                    .x = x + (float(glyph.offsetX) - padding) * scale,
+                    .y = y + (float(glyph.offsetY) - padding) * scale,
+                    .width = (rec.width + 2 * padding) * scale,
+                    .height = (rec.height + 2 * padding) * scale,
+                },
+            });
+        }
+        x += (glyph.advanceX == 0 ? rec.width : float(glyph.advanceX)) * scale + data.spacing;
+    }
+    end_line();
+    data.size = {.x = width, .y = y + data.font_size};
+}
+
+/// Layout of data, redone only when text, size, spacing or font glyphs have changed.
+/// Glyphs of dynamic font are required on every call, so that they stay cached while layout is drawn
+static auto quads(JSContext *js, TextLayoutClassData& data) -> const std::vector<GlyphQuad>& {
+    auto cache = data.font == 0 ? nullptr : GlyphCache::find(Engine::get(js).font_store().borrow(data.font));
+    if (cache) cache->require(data.text);
+    const auto generation = cache ? cache->generation() : 0;
+
+    const auto font = font_of(js, data);
+    if (data.dirty || data.glyphs != font.glyphs || data.generation != generation) {
+        layout(data, font);
+        data.generation = generation;
+    }
+    return data.quads;
+}
+
+/// Push cached quads into the active rlgl batch, transformed like DrawTextPro does
+static auto submit(
+    const ::Texture& texture,
+    const std::vector<GlyphQuad>& quads,
+    Vector2 position,
+    Vector2 origin,
+    float rotation,
+    Color color
+) noexcept -> void {
+    const auto tex_width = static_cast<float>(texture.width);
+    const auto tex_height = static_cast<float>(texture.height);
+
+    rlPushMatrix();
+    rlTranslatef(position.x, position.y, 0.0f);
+    rlRotatef(rotation, 0.0f, 0.0f, 1.0f);
+    rlTranslatef(-origin.x, -origin.y, 0.0f);
+
+    for (size_t first = 0; first < quads.size(); first += sprite_batch::CHUNK_SIZE) {
+        const auto last = std::min(quads.size(), first + sprite_batch::CHUNK_SIZE);
+
+        rlCheckRenderBatchLimit(int((last - first) * 4));
+        rlSetTexture(texture.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        for (const auto& [source, dest] : std::span(quads).subspan(first, last - first)) {
+            const auto u0 = source.x / tex_width;
+            const auto v0 = source.y / tex_height;
+            const auto u1 = (source.x + source.width) / tex_width;
+            const auto v1 = (source.y + source.height) / tex_height;
+
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(dest.x, dest.y);
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(dest.x, dest.y + dest.height);
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(dest.x + dest.width, dest.y);
+        }
+
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    rlPopMatrix();
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue;
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+static auto get_text(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_font_size(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_spacing(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_width(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto get_height(JSContext *js, JSValueConst this_val) -> JSValue;
+static auto set_text(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue;
+static auto set_font_size(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue;
+static auto set_spacing(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue;
+static auto to_string(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
+
+static const auto PROTO_FUNCS = std::array {
+    JSCFunctionListEntry JS_CGETSET_DEF("text", get_text, set_text),
+    JSCFunctionListEntry JS_CGETSET_DEF("fontSize", get_font_size, set_font_size),
+    JSCFunctionListEntry JS_CGETSET_DEF("spacing", get_spacing, set_spacing),
+    JSCFunctionListEntry JS_CGETSET_DEF("width", get_width, nullptr),
+    JSCFunctionListEntry JS_CGETSET_DEF("height", get_height, nullptr),
+    JSCFunctionListEntry JS_CFUNC_DEF("draw", 2, draw),
+    JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
+};
+
+extern const JSClassDef TEXT_LAYOUT = {
+    .class_name = "TextLayout",
+    .finalizer = finalizer,
+    .gc_mark = nullptr,
+    .call = nullptr,
+    .exotic = nullptr,
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:TextLayout", [](auto js, auto m) -> int {
+        JS_NewClass(JS_GetRuntime(js), js::class_id<&TEXT_LAYOUT>(js), &TEXT_LAYOUT);
+
+        JSValue proto = JS_NewObject(js);
+        JS_SetPropertyFunctionList(js, proto, PROTO_FUNCS.data(), int {PROTO_FUNCS.size()});
+        JS_SetClassProto(js, js::class_id<&TEXT_LAYOUT>(js), proto);
+
+        JSValue ctor = JS_NewCFunction2(js, constructor, "TextLayout", 1, JS_CFUNC_constructor, 0);
+        JS_SetConstructor(js, ctor, proto);
+
+        JS_SetModuleExport(js, m, "TextLayout", JS_DupValue(js, ctor));
+        JS_SetModuleExport(js, m, "default", ctor);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "TextLayout");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("TextLayout.constructor/{}", argc);
+    const auto args = js::unpack_args<js::Value>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto obj = js::Object::from_value(std::get<0>(*args));
+    if (!obj) return jsthrow(obj.error());
+    const auto& atoms = Engine::get(js).atoms();
+
+    const auto text = obj->at<std::string>(atoms[Atom::text]);
+    if (!text) return jsthrow(text.error());
+    const auto font_size = obj->at<float>(atoms[Atom::fontSize]);
+    if (!font_size) return jsthrow(font_size.error());
+    const auto spacing = obj->at<std::optional<float>>(atoms[Atom::spacing]);
+    if (!spacing) return jsthrow(spacing.error());
+    const auto font = obj->at<js::Value>(atoms[Atom::font]);
+    if (!font) return jsthrow(font.error());
+
+    auto font_handle = ResourceStore<FontData>::Handle {};
+    if (!JS_IsUndefined(font->cget())) {
+        const auto font_data =
+            static_cast<font::FontClassData *>(JS_GetOpaque(font->cget(), js::class_id<&font::CLASS>(js)));
+        if (font_data == nullptr) return JS_ThrowTypeError(js, "Expected Font object");
+        font_handle = font_data->handle;
+    }
+
+    auto proto = JS_GetPropertyStr(js, new_target, "prototype");
+    if (JS_IsException(proto)) {
+        return proto;
+    }
+    defer(JS_FreeValue(js, proto));
+
+    auto obj_val = JS_NewObjectProtoClass(js, proto, js::class_id<&TEXT_LAYOUT>(js));
+    if (JS_IsException(obj_val)) {
+        return obj_val;
+    }
+
+    // Layout keeps its own reference, so cached quads stay valid after Font object is collected
+    if (font_handle != 0) (void)Engine::get(js).font_store().get(font_handle);
+
+    auto data = owner<TextLayoutClassData *>(new TextLayoutClassData {
+        .font = font_handle,
+        .text = *text,
+        .font_size = *font_size,
+        .spacing = spacing->value_or(0),
+    });
+    JS_SetOpaque(obj_val, data);
+    return obj_val;
+}
+
+static auto finalizer(JSRuntime *rt, JSValueConst val) -> void {
+    SPDLOG_TRACE("Finalizing TextLayout");
+    auto ptr = owner<TextLayoutClassData *>(JS_GetOpaque(val, js::class_id<&TEXT_LAYOUT>(rt)));
+    if (ptr == nullptr) {
+        SPDLOG_WARN("Could not free TextLayout because opaque is null");
+        return;
+    }
+    if (ptr->font != 0) Engine::get(rt).font_store().release(ptr->font);
+    delete ptr;
+}
+
+static auto draw(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("TextLayout.draw/{}", argc);
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto args = js::unpack_args<Vector2, Color>(js, std::min(argc, 2), argv);
+    if (!args) return jsthrow(args.error());
+    const auto [position, color] = *args;
+
+    auto origin = Vector2 {};
+    if (argc >= 3 && !JS_IsUndefined(argv[2])) {
+        auto v = js::try_into<Vector2>(borrow(js, argv[2]));
+        if (!v) return jsthrow(v.error());
+        origin = *v;
+    }
+    auto rotation = 0.0f;
+    if (argc >= 4 && !JS_IsUndefined(argv[3])) {
+        auto v = js::try_into<float>(borrow(js, argv[3]));
+        if (!v) return jsthrow(v.error());
+        rotation = *v;
+    }
+
+    if (!IsWindowReady()) return JS_DupValue(js, this_val);
+
+    const auto& glyph_quads = quads(js, **data);
+    GLINT_TRACE_BINDING(
+        "TextLayout submit('{}', {} glyphs, {}, {})", (*data)->text, glyph_quads.size(), position, color
+    );
+    submit(font_of(js, **data).texture, glyph_quads, position, origin, rotation, color);
+
+    return JS_DupValue(js, this_val);
+}
+
+static auto get_text(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewStringLen(js, (*data)->text.data(), (*data)->text.size());
+}
+
+static auto get_font_size(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewFloat64(js, (*data)->font_size);
+}
+
+static auto get_spacing(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    return JS_NewFloat64(js, (*data)->spacing);
+}
+
+static auto get_width(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    (void)quads(js, **data);
+    return JS_NewFloat64(js, (*data)->size.x);
+}
+
+static auto get_height(JSContext *js, JSValueConst this_val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    (void)quads(js, **data);
+    return JS_NewFloat64(js, (*data)->size.y);
+}
+
+static auto set_text(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    auto text = js::try_into<std::string>(borrow(js, val));
+    if (!text) return jsthrow(text.error());
+    if ((*data)->text != *text) {
+        (*data)->text = std::move(*text);
+        (*data)->dirty = true;
+    }
+    return JS_UNDEFINED;
+}
+
+static auto set_font_size(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto font_size = js::try_into<float>(borrow(js, val));
+    if (!font_size) return jsthrow(font_size.error());
+    if ((*data)->font_size != *font_size) {
+        (*data)->font_size = *font_size;
+        (*data)->dirty = true;
+    }
+    return JS_UNDEFINED;
+}
+
+static auto set_spacing(JSContext *js, JSValueConst this_val, JSValueConst val) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto spacing = js::try_into<float>(borrow(js, val));
+    if (!spacing) return jsthrow(spacing.error());
+    if ((*data)->spacing != *spacing) {
+        (*data)->spacing = *spacing;
+        (*data)->dirty = true;
+    }
+    return JS_UNDEFINED;
+}
+
+static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
+    auto data = TextLayoutClassData::from_value(borrow(js, this_val));
+    if (!data) return jsthrow(data.error());
+    const auto str = fmt::format("TextLayout {{ text: '{}', fontSize: {} }}", (*data)->text, (*data)->font_size);
+    return JS_NewStringLen(js, str.data(), str.size());
+}
+
+} // namespace glint::plugins::graphics::text_layout
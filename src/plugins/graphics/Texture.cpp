@@ -8,6 +8,7 @@
 #include <raylib.h>
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
 #include <defer.hpp>
 #include <engine.hpp>
 #include <error.hpp>
@@ -83,8 +84,14 @@ inline auto read_texture_options_from_args(not_null<JSContext *> ctx, int argc,
     return Unexpected(JSError::plain_error(ctx, fmt::format("Unexpected C++ exception: {}", e.what())));
 }
 
+/// Synchronous load from file, also used to reload texture evicted from store
+static auto loader(std::filesystem::path path, IFileStore& store) -> ResourceStore<TextureData>::Loader {
+    return [path = std::move(path), &store]() -> TextureData { return TextureData::load(path, store); };
+}
+
 static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValueConst *argv) -> JSValue;
 static auto finalizer(JSRuntime *rt, JSValueConst val) -> void;
+static auto load(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
 static auto unload(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue;
 static auto get_source(JSContext *js, JSValueConst this_val) -> JSValue;
 static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue;
@@ -95,6 +102,10 @@ static const auto PROTO_FUNCS = std::array {
     JSCFunctionListEntry JS_CFUNC_DEF("toString", 0, to_string),
 };
 
+static const auto STATIC_FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("load", 1, load),
+};
+
 extern const JSClassDef TEXTURE = {
     .class_name = "Texture",
     .finalizer = finalizer,
@@ -112,6 +123,7 @@ auto module(JSContext *js) -> JSModuleDef * {
         JS_SetClassProto(js, js::class_id<&TEXTURE>(js), proto);
 
         JSValue ctor = JS_NewCFunction2(js, constructor, "Texture", 1, JS_CFUNC_constructor, 0);
+        JS_SetPropertyFunctionList(js, ctor, STATIC_FUNCS.data(), int {STATIC_FUNCS.size()});
         JS_SetConstructor(js, ctor, proto);
 
         JS_SetModuleExport(js, m, "default", ctor);
@@ -125,21 +137,19 @@ auto module(JSContext *js) -> JSModuleDef * {
 }
 
 static auto constructor(JSContext *js, JSValue new_target, int argc, JSValue *argv) -> JSValue {
-    SPDLOG_TRACE("Texture.constructor/{}", argc);
+    GLINT_TRACE_BINDING("Texture.constructor/{}", argc);
     auto opts = read_texture_options_from_args(js, argc, argv);
     if (!opts) return jsthrow(opts.error());
     auto& e = Engine::get(js);
 
     const auto handle = std::visit(
-        [&](auto&& arg) -> js::JSResult<int> {
+        [&](auto&& arg) -> js::JSResult<ResourceStore<TextureData>::Handle> {
             using T = std::decay_t<decltype(arg)>;
 
             if constexpr (std::is_same_v<T, TextureLoadByName>) {
                 return e.texture_store().load_by_name(arg.name);
             } else if constexpr (std::is_same_v<T, TextureLoadByParams>) {
-                return e.texture_store().load(arg.name, [&]() -> TextureData {
-                    return TextureData::load(arg.path, e.file_store());
-                });
+                return e.texture_store().load(arg.name, loader(arg.path, e.file_store()));
             } else if constexpr (std::is_same_v<T, std::monostate>) {
                 return Unexpected(js::JSError::type_error(js, "Either name or path must be present in options"));
             } else {
@@ -166,6 +176,73 @@ static auto constructor(JSContext *js, JSValue new_target, int argc, JSValue *ar
     return obj;
 }
 
+auto wrap(JSContext *js, ResourceStore<TextureData>::Handle handle) -> js::Value {
+    auto obj = js::own(js, JS_NewObjectClass(js, int(js::class_id<&TEXTURE>(js))));
+    if (JS_IsException(obj.cget())) {
+        Engine::get(js).texture_store().release(handle);
+        return obj;
+    }
+    auto data = owner<TextureClassData *> {new (std::nothrow) TextureClassData {.handle = handle}};
+    JS_SetOpaque(obj.cget(), data);
+    return obj;
+}
+
+/// Resolve promise with texture or reject it with exception thrown while wrapping
+static auto settle(js::Promise& promise, ResourceStore<TextureData>::Handle handle) -> void {
+    auto obj = wrap(promise.ctx(), handle);
+    if (JS_IsException(obj.cget())) {
+        return promise.reject(js::JSError::from_value(js::own(promise.ctx(), JS_GetException(promise.ctx()))));
+    }
+    promise.resolve(obj);
+}
+
+static auto load(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("Texture.load/{}", argc);
+    auto opts = read_texture_options_from_args(js, argc, argv);
+    if (!opts) return jsthrow(opts.error());
+    auto promise = js::Promise::create(js);
+    if (!promise) return jsthrow(promise.error());
+    auto& e = Engine::get(js);
+
+    if (auto by_name = std::get_if<TextureLoadByName>(&*opts)) {
+        const auto handle = e.texture_store().load_by_name(by_name->name);
+        if (handle == 0) {
+            auto message = fmt::format("No texture named {}", by_name->name);
+            promise->reject(js::JSError::plain_error(js, message));
+        } else {
+            settle(*promise, handle);
+        }
+        return promise->object();
+    }
+
+    auto params = std::get_if<TextureLoadByParams>(&*opts);
+    if (params == nullptr) {
+        return jsthrow(js::JSError::type_error(js, "Either name or path must be present in options"));
+    }
+
+    // Texture that is already loaded under that name is shared without reading file again
+    if (const auto handle = e.texture_store().load_by_name(params->name); handle != 0) {
+        settle(*promise, handle);
+        return promise->object();
+    }
+
+    auto result = promise->object();
+    e.asset_loader().submit(
+        [&store = e.file_store(), path = params->path] { return TextureData::decode(path, store); },
+        [promise = std::move(*promise), params = std::move(*params)](Result<rl::Image>&& image) mutable {
+            if (!image) {
+                auto message = fmt::format("Could not load texture {}: {}", params.path.string(), image.error()->msg());
+                return promise.reject(js::JSError::plain_error(promise.ctx(), message));
+            }
+            auto& e = Engine::get(promise.ctx());
+            const auto upload = [&]() -> TextureData { return TextureData::from_image(params.path, *image); };
+            const auto handle = e.texture_store().load(params.name, upload, loader(params.path, e.file_store()));
+            settle(promise, handle);
+        }
+    );
+    return result;
+}
+
 static auto finalizer(JSRuntime *rt, JSValue val) -> void {
     SPDLOG_TRACE("Finalizing Texture");
     auto ptr = owner<TextureClassData *>(JS_GetOpaque(val, js::class_id<&TEXTURE>(rt)));
@@ -179,11 +256,13 @@ static auto finalizer(JSRuntime *rt, JSValue val) -> void {
 }
 
 static auto unload(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
-    SPDLOG_TRACE("Texture.unload/{}", argc);
+    GLINT_TRACE_BINDING("Texture.unload/{}", argc);
     auto ptr = owner<TextureClassData *>(JS_GetOpaque(this_val, js::class_id<&TEXTURE>(js)));
     if (!ptr) return JS_ThrowTypeError(js, "Not an instance of Texture");
     auto& e = Engine::get(js);
-    e.texture_store().release(ptr->handle);
+    e.texture_store().release(ptr->handle, false);
+    // Finalizer must not release it again
+    ptr->handle = 0;
     return JS_UNDEFINED;
 }
 
@@ -191,15 +270,15 @@ static auto get_source(JSContext *js, JSValueConst this_val) -> JSValue {
     const auto tex = js::try_into<const rl::Texture *>(js::borrow(js, this_val));
     if (!tex) return jsthrow(tex.error());
 
-    const auto obj = JS_NewObjectClass(js, js::class_id<&math::rectangle::RECTANGLE>(js));
-    const auto rec = owner<Rectangle *> {new (std::nothrow) Rectangle {
-        .x = 0.0f,
-        .y = 0.0f,
-        .width = static_cast<float>((*tex)->width),
-        .height = static_cast<float>((*tex)->height),
-    }};
-    JS_SetOpaque(obj, rec);
-    return obj;
+    return math::rectangle::create(
+        js,
+        Rectangle {
+            .x = 0.0f,
+            .y = 0.0f,
+            .width = static_cast<float>((*tex)->width),
+            .height = static_cast<float>((*tex)->height),
+        }
+    );
 }
 
 static auto to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
@@ -6,15 +6,20 @@ auto plugin(JSContext *js) -> EnginePlugin {
     return EnginePlugin {
         .name = "graphics",
         .c_modules = {
+            {"glint:Atlas", atlas::module(js)},
             {"glint:Camera", camera::module(js)},
             {"glint:Color", color::module(js)},
             {"glint:Font", font::module(js)},
             {"glint:NPatch", npatch::module(js)},
+            {"glint:ParticleEmitter", particle_emitter::module(js)},
+            {"glint:SpriteBatch", sprite_batch::module(js)},
+            {"glint:TextLayout", text_layout::module(js)},
             {"glint:Texture", texture::module(js)},
             {"glint:graphics", module(js)},
         },
         .draw = []() -> Result<> {
-            ClearBackground(BLACK);
+            // Draw callbacks also run headless, where there is no GPU context to clear
+            if (IsWindowReady()) ClearBackground(BLACK);
             return {};
         }
     };
@@ -7,7 +7,9 @@
 #include <raylib.h>
 #include <spdlog/spdlog.h>
 
+#include <binding_trace.hpp>
 #include <defer.hpp>
+#include <engine.hpp>
 #include <plugins/math.hpp>
 #include <quickjs.hpp>
 
@@ -28,35 +30,37 @@ auto try_into<Text>(const Value& val) noexcept -> JSResult<Text> {
     auto text = Text {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto t = obj->at<std::string>("text")) {
+    if (auto t = obj->at<std::string>(atoms[Atom::text])) {
         text.text = std::move(*t);
-    } else if (auto c = obj->at<int>("codepoint")) {
+    } else if (auto c = obj->at<int>(atoms[Atom::codepoint])) {
         text.text = *c;
-    } else if (auto cs = obj->at<std::vector<int>>("codepoints")) {
+    } else if (auto cs = obj->at<std::vector<int>>(atoms[Atom::codepoints])) {
         text.text = std::move(*cs);
     } else {
         return Unexpected(
             JSError::type_error(
                 val.ctx(),
-                "Text object must either have `text` (string), `codepoint` (number) or `codepoints` (number[]) property"
+                "Text object must either have `text` (string), `codepoint` (number) or `codepoints` "
+                "(number[] or Int32Array) property"
             )
         );
     }
 
-    if (auto v = obj->at<float>("fontSize")) text.font_size = *v;
+    if (auto v = obj->at<float>(atoms[Atom::fontSize])) text.font_size = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<Vector2>("position")) text.position = *v;
+    if (auto v = obj->at<Vector2>(atoms[Atom::position])) text.position = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<Color>("color")) text.color = *v;
+    if (auto v = obj->at<Color>(atoms[Atom::color])) text.color = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<std::optional<Vector2>>("origin")) text.origin = *v;
+    if (auto v = obj->at<std::optional<Vector2>>(atoms[Atom::origin])) text.origin = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<std::optional<float>>("rotation")) text.rotation = *v;
+    if (auto v = obj->at<std::optional<float>>(atoms[Atom::rotation])) text.rotation = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<std::optional<float>>("spacing")) text.spacing = *v;
+    if (auto v = obj->at<std::optional<float>>(atoms[Atom::spacing])) text.spacing = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<std::optional<const rl::Font *>>("font")) text.font = *v;
+    if (auto v = obj->at<std::optional<const rl::Font *>>(atoms[Atom::font])) text.font = *v;
     else return Unexpected(v.error());
 
     return text;
@@ -67,156 +71,177 @@ auto try_into<Text>(const Value& val) noexcept -> JSResult<Text> {
 namespace glint::plugins::graphics {
 
 static auto clear(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.clear/{}", argc);
+    GLINT_TRACE_BINDING("graphics.clear/{}", argc);
     const auto args = js::unpack_args<Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [color] = *args;
-    SPDLOG_TRACE("ClearBackground({})", color);
+    GLINT_TRACE_BINDING("ClearBackground({})", color);
     ClearBackground(color);
     return JS_DupValue(js, this_val);
 }
 
 static auto circle_simple(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.circle/{}", argc);
+    GLINT_TRACE_BINDING("graphics.circle/{}", argc);
     const auto args = js::unpack_args<int, int, float, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [x, y, radius, color] = *args;
-    SPDLOG_TRACE("DrawCircle({}, {}, {}, {})", x, y, radius, color);
+    GLINT_TRACE_BINDING("DrawCircle({}, {}, {}, {})", x, y, radius, color);
     DrawCircle(x, y, radius, color);
     return JS_DupValue(js, this_val);
 }
 
 static auto rectangle_simple(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.rectangle/{}", argc);
+    GLINT_TRACE_BINDING("graphics.rectangle/{}", argc);
     const auto args = js::unpack_args<int, int, int, int, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [x, y, width, height, color] = *args;
-    SPDLOG_TRACE("DrawRectangle({}, {}, {}, {}, {})", x, y, width, height, color);
+    GLINT_TRACE_BINDING("DrawRectangle({}, {}, {}, {}, {})", x, y, width, height, color);
     DrawRectangle(x, y, width, height, color);
     return JS_DupValue(js, this_val);
 }
 
 static auto rectangle_v(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.rectangleV/{}", argc);
+    GLINT_TRACE_BINDING("graphics.rectangleV/{}", argc);
     const auto args = js::unpack_args<Vector2, Vector2, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [position, size, color] = *args;
-    SPDLOG_TRACE("DrawRectangleV({}, {}, {})", position, size, color);
+    GLINT_TRACE_BINDING("DrawRectangleV({}, {}, {})", position, size, color);
     DrawRectangleV(position, size, color);
     return JS_DupValue(js, this_val);
 }
 
 static auto rectangle_rec(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.rectangleRec/{}", argc);
+    GLINT_TRACE_BINDING("graphics.rectangleRec/{}", argc);
     const auto args = js::unpack_args<Rectangle, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [rec, color] = *args;
-    SPDLOG_TRACE("DrawRectangleRec({}, {})", rec, color);
+    GLINT_TRACE_BINDING("DrawRectangleRec({}, {})", rec, color);
     DrawRectangleRec(rec, color);
     return JS_DupValue(js, this_val);
 }
 
 static auto rectangle_pro(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.rectanglePro/{}", argc);
+    GLINT_TRACE_BINDING("graphics.rectanglePro/{}", argc);
     const auto args = js::unpack_args<Rectangle, Vector2, float, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [rec, origin, rotation, color] = *args;
-    SPDLOG_TRACE("DrawRectanglePro({}, {}, {}, {})", rec, origin, rotation, color);
+    GLINT_TRACE_BINDING("DrawRectanglePro({}, {}, {}, {})", rec, origin, rotation, color);
     DrawRectanglePro(rec, origin, rotation, color);
     return JS_DupValue(js, this_val);
 }
 
 static auto begin_camera_mode(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.beginCameraMode/{}", argc);
+    GLINT_TRACE_BINDING("graphics.beginCameraMode/{}", argc);
     const auto args = js::unpack_args<Camera2D>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [camera] = *args;
-    SPDLOG_TRACE("BeginMode2D({})", camera);
+    GLINT_TRACE_BINDING("BeginMode2D({})", camera);
     BeginMode2D(camera);
     return JS_DupValue(js, this_val);
 }
 
 static auto end_camera_mode(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
-    SPDLOG_TRACE("graphics.beginCameraMode/{}", argc);
-    SPDLOG_TRACE("BeginMode2D()");
+    GLINT_TRACE_BINDING("graphics.beginCameraMode/{}", argc);
+    GLINT_TRACE_BINDING("BeginMode2D()");
     EndMode2D();
     return JS_DupValue(js, this_val);
 }
 
 static auto texture_simple(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.texture/{}", argc);
-    const auto args = js::unpack_args<const rl::Texture *, int, int, Color>(js, argc, argv);
+    GLINT_TRACE_BINDING("graphics.texture/{}", argc);
+    const auto args = js::unpack_args<texture::TextureRegion, int, int, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [texture, x, y, tint] = *args;
-    SPDLOG_TRACE("DrawTexture({}, {}, {}, {})", *texture, x, y, tint);
-    DrawTexture(*texture, x, y, tint);
+    const auto position = Vector2 {static_cast<float>(x), static_cast<float>(y)};
+    GLINT_TRACE_BINDING("DrawTextureRec({}, {}, {}, {})", *texture.texture, texture.source, position, tint);
+    DrawTextureRec(*texture.texture, texture.source, position, tint);
     return JS_DupValue(js, this_val);
 }
 
 static auto texture_v(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.textureV/{}", argc);
-    const auto args = js::unpack_args<const rl::Texture *, Vector2, Color>(js, argc, argv);
+    GLINT_TRACE_BINDING("graphics.textureV/{}", argc);
+    const auto args = js::unpack_args<texture::TextureRegion, Vector2, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [texture, position, tint] = *args;
-    SPDLOG_TRACE("DrawTextureV({}, {}, {})", *texture, position, tint);
-    DrawTextureV(*texture, position, tint);
+    GLINT_TRACE_BINDING("DrawTextureRec({}, {}, {}, {})", *texture.texture, texture.source, position, tint);
+    DrawTextureRec(*texture.texture, texture.source, position, tint);
     return JS_DupValue(js, this_val);
 }
 
 static auto texture_ex(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.textureEx/{}", argc);
-    const auto args = js::unpack_args<const rl::Texture *, Vector2, float, float, Color>(js, argc, argv);
+    GLINT_TRACE_BINDING("graphics.textureEx/{}", argc);
+    const auto args = js::unpack_args<texture::TextureRegion, Vector2, float, float, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [texture, position, rotation, scale, tint] = *args;
-    SPDLOG_TRACE("DrawTextureEx({}, {}, {}, {}, {})", *texture, position, rotation, scale, tint);
-    DrawTextureEx(*texture, position, rotation, scale, tint);
+    const auto& source = texture.source;
+    const auto dest = Rectangle {position.x, position.y, source.width * scale, source.height * scale};
+    const auto origin = Vector2 {0.0f, 0.0f};
+    GLINT_TRACE_BINDING(
+        "DrawTexturePro({}, {}, {}, {}, {}, {})", *texture.texture, source, dest, origin, rotation, tint
+    );
+    DrawTexturePro(*texture.texture, source, dest, origin, rotation, tint);
     return JS_DupValue(js, this_val);
 }
 
+/// Move source rectangle given relative to texture region into its texture
+static auto in_region(const texture::TextureRegion& texture, Rectangle source) noexcept -> Rectangle {
+    source.x += texture.source.x;
+    source.y += texture.source.y;
+    return source;
+}
+
 static auto texture_rec(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.textureRec/{}", argc);
-    const auto args = js::unpack_args<const rl::Texture *, Rectangle, Vector2, Color>(js, argc, argv);
+    GLINT_TRACE_BINDING("graphics.textureRec/{}", argc);
+    const auto args = js::unpack_args<texture::TextureRegion, Rectangle, Vector2, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
-    const auto [texture, source, position, tint] = *args;
-    SPDLOG_TRACE("DrawTextureRec({}, {}, {}, {})", *texture, source, position, tint);
-    DrawTextureRec(*texture, source, position, tint);
+    const auto [texture, rec, position, tint] = *args;
+    const auto source = in_region(texture, rec);
+    GLINT_TRACE_BINDING("DrawTextureRec({}, {}, {}, {})", *texture.texture, source, position, tint);
+    DrawTextureRec(*texture.texture, source, position, tint);
     return JS_DupValue(js, this_val);
 }
 
 static auto texture_pro(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.texturePro/{}", argc);
-    const auto args = js::unpack_args<const rl::Texture *, Rectangle, Rectangle, Vector2, float, Color>(js, argc, argv);
+    GLINT_TRACE_BINDING("graphics.texturePro/{}", argc);
+    const auto args =
+        js::unpack_args<texture::TextureRegion, Rectangle, Rectangle, Vector2, float, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
-    const auto [texture, source, dest, origin, rotation, tint] = *args;
-    SPDLOG_TRACE("DrawTexturePro({}, {}, {}, {}, {}, {})", *texture, source, dest, origin, rotation, tint);
-    DrawTexturePro(*texture, source, dest, origin, rotation, tint);
+    const auto [texture, rec, dest, origin, rotation, tint] = *args;
+    const auto source = in_region(texture, rec);
+    GLINT_TRACE_BINDING(
+        "DrawTexturePro({}, {}, {}, {}, {}, {})", *texture.texture, source, dest, origin, rotation, tint
+    );
+    DrawTexturePro(*texture.texture, source, dest, origin, rotation, tint);
     return JS_DupValue(js, this_val);
 }
 
 static auto texture_npatch(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.texturePro/{}", argc);
+    GLINT_TRACE_BINDING("graphics.texturePro/{}", argc);
     const auto args =
-        js::unpack_args<const rl::Texture *, NPatchInfo, Rectangle, Vector2, float, Color>(js, argc, argv);
+        js::unpack_args<texture::TextureRegion, NPatchInfo, Rectangle, Vector2, float, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
-    const auto [texture, npatch, dest, origin, rotation, tint] = *args;
-    SPDLOG_TRACE("DrawTextureNPatch({}, {}, {}, {}, {}, {});", *texture, npatch, dest, origin, rotation, tint);
-    DrawTextureNPatch(*texture, npatch, dest, origin, rotation, tint);
+    auto [texture, npatch, dest, origin, rotation, tint] = *args;
+    npatch.source = in_region(texture, npatch.source);
+    GLINT_TRACE_BINDING(
+        "DrawTextureNPatch({}, {}, {}, {}, {}, {});", *texture.texture, npatch, dest, origin, rotation, tint
+    );
+    DrawTextureNPatch(*texture.texture, npatch, dest, origin, rotation, tint);
     return JS_DupValue(js, this_val);
 }
 
 static auto text_simple(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.text/{}", argc);
+    GLINT_TRACE_BINDING("graphics.text/{}", argc);
     const auto args = js::unpack_args<std::string, int, int, int, Color>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [text, x, y, font_size, color] = *args;
-    SPDLOG_TRACE("DrawText('{}', {}, {}, {}, {})", text, x, y, font_size, color);
+    GLINT_TRACE_BINDING("DrawText('{}', {}, {}, {}, {})", text, x, y, font_size, color);
     DrawText(text.c_str(), x, y, font_size, color);
 
     return JS_DupValue(js, this_val);
 }
 
 static auto text_pro(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.textPro/{}", argc);
+    GLINT_TRACE_BINDING("graphics.textPro/{}", argc);
     auto args = js::unpack_args<js::Text>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [text] = *args;
@@ -228,18 +253,26 @@ static auto text_pro(JSContext *js, JSValueConst this_val, int argc, JSValueCons
     const auto rotation = text.rotation.value_or(0);
     const auto spacing = text.spacing.value_or(0);
     auto font = GetFontDefault();
-    if (text.font) font = ::Font {**text.font};
+    if (text.font) {
+        // Glyph cache may grow font arrays and texture, so font is copied after its glyphs are in place
+        if (auto cache = GlyphCache::find(**text.font)) {
+            if (const auto str = std::get_if<std::string>(&text.text)) cache->require(*str);
+            else if (const auto codepoint = std::get_if<int>(&text.text)) cache->require(std::span(codepoint, 1));
+            else if (const auto codepoints = std::get_if<std::vector<int>>(&text.text)) cache->require(*codepoints);
+        }
+        font = ::Font {**text.font};
+    }
 
     if (const auto str = std::get_if<std::string>(&text.text)) {
-        SPDLOG_TRACE("DrawTextPro({}, '{}', {}, {}, {})", font, *str, position, font_size, color);
+        GLINT_TRACE_BINDING("DrawTextPro({}, '{}', {}, {}, {})", font, *str, position, font_size, color);
         DrawTextPro(font, str->c_str(), position, origin, rotation, font_size, spacing, color);
 
     } else if (const auto codepoint = std::get_if<int>(&text.text)) {
-        SPDLOG_TRACE("DrawTextCodepoint(font, {}, {}, {}, {})", font, *codepoint, position, font_size, color);
+        GLINT_TRACE_BINDING("DrawTextCodepoint(font, {}, {}, {}, {})", font, *codepoint, position, font_size, color);
         DrawTextCodepoint(font, *codepoint, position, font_size, color);
 
     } else if (const auto codepoints = std::get_if<std::vector<int>>(&text.text)) {
-        SPDLOG_TRACE(
+        GLINT_TRACE_BINDING(
             "DrawTextCodepoints({}, {}, {}, {}, {}, {})",
             font,
             (void *)codepoints->data(),
@@ -255,33 +288,35 @@ static auto text_pro(JSContext *js, JSValueConst this_val, int argc, JSValueCons
 }
 
 static auto begin_texture_mode(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.beginTextureMode/{}", argc);
+    GLINT_TRACE_BINDING("graphics.beginTextureMode/{}", argc);
     const auto args = js::unpack_args<const rl::RenderTexture *>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [texture] = *args;
-    SPDLOG_TRACE("BeginTextureMode({})", *texture);
+    GLINT_TRACE_BINDING("BeginTextureMode({})", *texture);
     BeginTextureMode(*texture);
     return JS_DupValue(js, this_val);
 }
 
 static auto end_texture_mode(JSContext *js, JSValueConst this_val, int argc, JSValueConst *) -> JSValue {
-    SPDLOG_TRACE("graphics.endTextureMode/{}", argc);
-    SPDLOG_TRACE("EndTextureMode()");
+    GLINT_TRACE_BINDING("graphics.endTextureMode/{}", argc);
+    GLINT_TRACE_BINDING("EndTextureMode()");
     EndTextureMode();
     return JS_DupValue(js, this_val);
 }
 
 static auto with_texture(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
-    SPDLOG_TRACE("graphics.withTexture/{}", argc);
+    GLINT_TRACE_BINDING("graphics.withTexture/{}", argc);
     const auto args = js::unpack_args<const rl::RenderTexture *, JSValue>(js, argc, argv);
     if (!args) return jsthrow(args.error());
     const auto [texture, function] = *args;
 
-    SPDLOG_TRACE("BeginTextureMode({})", *texture);
-    BeginTextureMode(*texture);
+    // Callback still runs in headless mode, only texture mode is skipped
+    const auto drawing = IsWindowReady();
+    GLINT_TRACE_BINDING("BeginTextureMode({})", *texture);
+    if (drawing) BeginTextureMode(*texture);
     auto ret = JS_Call(js, function, JS_UNDEFINED, 0, nullptr);
-    SPDLOG_TRACE("EndTextureMode()");
-    EndTextureMode();
+    GLINT_TRACE_BINDING("EndTextureMode()");
+    if (drawing) EndTextureMode();
     if (JS_IsException(ret)) {
         return ret;
     }
@@ -290,25 +325,32 @@ static auto with_texture(JSContext *js, JSValueConst this_val, int argc, JSValue
     return JS_DupValue(js, this_val);
 }
 
+/// Drawing needs GPU context, so without window (headless run) drawing functions do nothing
+template<JSCFunction *F>
+static auto when_drawing(JSContext *js, JSValueConst this_val, int argc, JSValueConst *argv) -> JSValue {
+    if (!IsWindowReady()) return JS_DupValue(js, this_val);
+    return F(js, this_val, argc, argv);
+}
+
 static const auto FUNCS = std::array {
-    JSCFunctionListEntry JS_CFUNC_DEF("clear", 1, clear),
-    JSCFunctionListEntry JS_CFUNC_DEF("circle", 4, circle_simple),
-    JSCFunctionListEntry JS_CFUNC_DEF("rectangle", 5, rectangle_simple),
-    JSCFunctionListEntry JS_CFUNC_DEF("rectangleV", 3, rectangle_v),
-    JSCFunctionListEntry JS_CFUNC_DEF("rectangleRec", 2, rectangle_rec),
-    JSCFunctionListEntry JS_CFUNC_DEF("rectanglePro", 4, rectangle_pro),
-    JSCFunctionListEntry JS_CFUNC_DEF("beginCameraMode", 1, begin_camera_mode),
-    JSCFunctionListEntry JS_CFUNC_DEF("endCameraMode", 0, end_camera_mode),
-    JSCFunctionListEntry JS_CFUNC_DEF("texture", 4, texture_simple),
-    JSCFunctionListEntry JS_CFUNC_DEF("textureV", 3, texture_v),
-    JSCFunctionListEntry JS_CFUNC_DEF("textureEx", 5, texture_ex),
-    JSCFunctionListEntry JS_CFUNC_DEF("textureRec", 4, texture_rec),
-    JSCFunctionListEntry JS_CFUNC_DEF("texturePro", 6, texture_pro),
-    JSCFunctionListEntry JS_CFUNC_DEF("textureNPatch", 6, texture_npatch),
-    JSCFunctionListEntry JS_CFUNC_DEF("text", 5, text_simple),
-    JSCFunctionListEntry JS_CFUNC_DEF("textPro", 1, text_pro),
-    JSCFunctionListEntry JS_CFUNC_DEF("beginTextureMode", 1, begin_texture_mode),
-    JSCFunctionListEntry JS_CFUNC_DEF("endTextureMode", 0, end_texture_mode),
+    JSCFunctionListEntry JS_CFUNC_DEF("clear", 1, when_drawing<clear>),
+    JSCFunctionListEntry JS_CFUNC_DEF("circle", 4, when_drawing<circle_simple>),
+    JSCFunctionListEntry JS_CFUNC_DEF("rectangle", 5, when_drawing<rectangle_simple>),
+    JSCFunctionListEntry JS_CFUNC_DEF("rectangleV", 3, when_drawing<rectangle_v>),
+    JSCFunctionListEntry JS_CFUNC_DEF("rectangleRec", 2, when_drawing<rectangle_rec>),
+    JSCFunctionListEntry JS_CFUNC_DEF("rectanglePro", 4, when_drawing<rectangle_pro>),
+    JSCFunctionListEntry JS_CFUNC_DEF("beginCameraMode", 1, when_drawing<begin_camera_mode>),
+    JSCFunctionListEntry JS_CFUNC_DEF("endCameraMode", 0, when_drawing<end_camera_mode>),
+    JSCFunctionListEntry JS_CFUNC_DEF("texture", 4, when_drawing<texture_simple>),
+    JSCFunctionListEntry JS_CFUNC_DEF("textureV", 3, when_drawing<texture_v>),
+    JSCFunctionListEntry JS_CFUNC_DEF("textureEx", 5, when_drawing<texture_ex>),
+    JSCFunctionListEntry JS_CFUNC_DEF("textureRec", 4, when_drawing<texture_rec>),
+    JSCFunctionListEntry JS_CFUNC_DEF("texturePro", 6, when_drawing<texture_pro>),
+    JSCFunctionListEntry JS_CFUNC_DEF("textureNPatch", 6, when_drawing<texture_npatch>),
+    JSCFunctionListEntry JS_CFUNC_DEF("text", 5, when_drawing<text_simple>),
+    JSCFunctionListEntry JS_CFUNC_DEF("textPro", 1, when_drawing<text_pro>),
+    JSCFunctionListEntry JS_CFUNC_DEF("beginTextureMode", 1, when_drawing<begin_texture_mode>),
+    JSCFunctionListEntry JS_CFUNC_DEF("endTextureMode", 0, when_drawing<end_texture_mode>),
     JSCFunctionListEntry JS_CFUNC_DEF("withTexture", 2, with_texture),
 };
 
@@ -1,3 +1,4 @@
 #include "./math/descriptor.cpp"
 #include "./math/Rectangle.cpp"
+#include "./math/simd.cpp"
 #include "./math/Vector2.cpp"
@@ -14,14 +14,25 @@ namespace vector2 {
     extern const JSClassDef VECTOR2;
     auto module(JSContext *js) -> ::JSModuleDef *;
     auto to_string(Vector2 vec) -> std::string;
+
+    /// Create new Vector2 object, storing value in engine pool
+    auto create(JSContext *js, Vector2 vec) -> JSValue;
 } // namespace vector2
 
 namespace rectangle {
     extern const JSClassDef RECTANGLE;
     auto module(JSContext *js) -> ::JSModuleDef *;
     auto to_string(Rectangle rec) -> std::string;
+
+    /// Create new Rectangle object, storing value in engine pool
+    auto create(JSContext *js, Rectangle rec) -> JSValue;
 } // namespace rectangle
 
+/// Kernels over Float32Array of xy pairs
+namespace simd {
+    auto module(JSContext *js) -> ::JSModuleDef *;
+} // namespace simd
+
 } // namespace glint::plugins::math
 
 namespace glint::js {
@@ -7,6 +7,7 @@
 #include <raylib.h>
 
 #include <defer.hpp>
+#include <engine.hpp>
 
 namespace glint::js {
 
@@ -28,14 +29,15 @@ auto try_into<Rectangle>(const Value& val) noexcept -> JSResult<Rectangle> {
     auto rec = ::Rectangle {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto v = obj->at<float>("x")) rec.x = *v;
+    if (auto v = obj->at<float>(atoms[Atom::x])) rec.x = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("y")) rec.y = *v;
+    if (auto v = obj->at<float>(atoms[Atom::y])) rec.y = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("width")) rec.width = *v;
+    if (auto v = obj->at<float>(atoms[Atom::width])) rec.width = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("height")) rec.height = *v;
+    if (auto v = obj->at<float>(atoms[Atom::height])) rec.height = *v;
     else return Unexpected(v.error());
 
     return rec;
@@ -64,22 +66,19 @@ static auto constructor(JSContext *js, JSValueConst new_target, int argc, JSValu
         return JS_GetException(js);
     }
 
-    auto rec = owner<Rectangle *>(new Rectangle {.x = x, .y = y, .width = width, .height = height});
+    auto rec = Engine::get(js).rectangle_pool().create(Rectangle {.x = x, .y = y, .width = width, .height = height});
     JS_SetOpaque(obj, rec);
     return obj;
 }
 
 static auto finalizer(JSRuntime *rt, JSValue val) {
     auto ptr = owner<Rectangle *>(JS_GetOpaque(val, js::class_id<&RECTANGLE>(rt)));
-    delete ptr;
+    Engine::get(rt).rectangle_pool().destroy(ptr);
 }
 
 static auto zero(JSContext *js, JSValueConst, int, JSValueConst *) -> JSValue {
     // TODO: maybe we should get proto from this_value?
-    auto obj = JS_NewObjectClass(js, js::class_id<&RECTANGLE>(js));
-    auto rec = owner<Rectangle *>(new Rectangle {.x = 0, .y = 0, .width = 0, .height = 0});
-    JS_SetOpaque(obj, rec);
-    return obj;
+    return create(js, Rectangle {.x = 0, .y = 0, .width = 0, .height = 0});
 }
 
 static auto from_vectors(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
@@ -90,15 +89,15 @@ static auto from_vectors(JSContext *js, JSValueConst, int argc, JSValueConst *ar
     const auto [pos, size] = *args;
 
     // TODO: maybe we should get proto from this_value?
-    auto obj = JS_NewObjectClass(js, js::class_id<&RECTANGLE>(js));
-    auto rec = owner<Rectangle *>(new Rectangle {
-        .x = pos.x,
-        .y = pos.y,
-        .width = size.x,
-        .height = size.y,
-    });
-    JS_SetOpaque(obj, rec);
-    return obj;
+    return create(
+        js,
+        Rectangle {
+            .x = pos.x,
+            .y = pos.y,
+            .width = size.x,
+            .height = size.y,
+        }
+    );
 }
 
 static auto get_x(JSContext *js, JSValueConst this_val) -> JSValue {
@@ -218,6 +217,13 @@ auto module(JSContext *js) -> JSModuleDef * {
     return m;
 }
 
+auto create(JSContext *js, Rectangle rec) -> JSValue {
+    auto obj = JS_NewObjectClass(js, js::class_id<&RECTANGLE>(js));
+    if (JS_IsException(obj)) return obj;
+    JS_SetOpaque(obj, Engine::get(js).rectangle_pool().create(rec));
+    return obj;
+}
+
 auto to_string(Rectangle rec) -> std::string {
     return fmt::format("Rectangle {{ x: {}, y: {}, width: {}, height: {} }}", rec.x, rec.y, rec.width, rec.height);
 }
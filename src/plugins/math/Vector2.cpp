@@ -9,6 +9,7 @@
 #include <raymath.h>
 
 #include <defer.hpp>
+#include <engine.hpp>
 
 namespace glint::js {
 
@@ -27,10 +28,11 @@ auto try_into<Vector2>(const Value& val) noexcept -> JSResult<Vector2> {
     auto vec = Vector2 {};
     auto obj = Object::from_value(val);
     if (!obj) return Unexpected(obj.error());
+    const auto& atoms = Engine::get(val.ctx()).atoms();
 
-    if (auto v = obj->at<float>("x")) vec.x = *v;
+    if (auto v = obj->at<float>(atoms[Atom::x])) vec.x = *v;
     else return Unexpected(v.error());
-    if (auto v = obj->at<float>("y")) vec.y = *v;
+    if (auto v = obj->at<float>(atoms[Atom::y])) vec.y = *v;
     else return Unexpected(v.error());
 
     return vec;
@@ -107,7 +109,7 @@ static auto constructor(JSContext *js, JSValue new_target, int argc, JSValue *ar
         return JS_GetException(js);
     }
 
-    auto new_vec = owner<Vector2 *>(new Vector2 {*v});
+    auto new_vec = Engine::get(js).vector2_pool().create(*v);
     JS_SetOpaque(obj, new_vec);
 
     return obj;
@@ -119,21 +121,15 @@ static auto finalizer(JSRuntime *rt, JSValueConst val) {
         SPDLOG_WARN("Could not free Vector2 because opaque is null");
         return;
     }
-    delete ptr;
+    Engine::get(rt).vector2_pool().destroy(ptr);
 }
 
 static auto zero(JSContext *js, JSValueConst, int, JSValueConst *) -> JSValue {
-    auto obj = JS_NewObjectClass(js, js::class_id<&VECTOR2>(js));
-    auto vec = owner<Vector2 *>(new Vector2 {.x = 0, .y = 0});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return create(js, Vector2 {.x = 0, .y = 0});
 }
 
 static auto one(JSContext *js, JSValueConst, int, JSValueConst *) -> JSValue {
-    auto obj = JS_NewObjectClass(js, js::class_id<&VECTOR2>(js));
-    auto vec = owner<Vector2 *>(new Vector2 {.x = 1, .y = 1});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return create(js, Vector2 {.x = 1, .y = 1});
 }
 
 static auto get_x(JSContext *js, JSValueConst this_val) -> JSValue {
@@ -406,16 +402,7 @@ static auto refract(JSContext *js, JSValueConst this_val, int argc, JSValueConst
 static auto clone(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
     auto this_vec = js::try_into<Vector2 *>(js::borrow(js, this_val));
     if (!this_vec) return jsthrow(this_vec.error());
-
-    auto obj = JS_NewObjectClass(js, js::class_id<&VECTOR2>(js));
-    if (JS_HasException(js)) {
-        JS_FreeValue(js, obj);
-        return JS_Throw(js, JS_GetException(js));
-    }
-
-    auto new_vec = owner<Vector2 *>(new Vector2 {**this_vec});
-    JS_SetOpaque(obj, new_vec);
-    return obj;
+    return create(js, **this_vec);
 }
 
 static auto object_to_string(JSContext *js, JSValueConst this_val, int, JSValueConst *) -> JSValue {
@@ -495,6 +482,13 @@ auto module(JSContext *js) -> JSModuleDef * {
     return m;
 }
 
+auto create(JSContext *js, Vector2 vec) -> JSValue {
+    auto obj = JS_NewObjectClass(js, js::class_id<&VECTOR2>(js));
+    if (JS_IsException(obj)) return obj;
+    JS_SetOpaque(obj, Engine::get(js).vector2_pool().create(vec));
+    return obj;
+}
+
 auto to_string(::Vector2 vec) -> std::string {
     return fmt::format("Vector2 {{ x: {}, y: {} }}", vec.x, vec.y);
 }
@@ -8,6 +8,7 @@ auto plugin(JSContext *js) -> EnginePlugin {
         .c_modules = {
             {"glint:Vector2", vector2::module(js)},
             {"glint:Rectangle", rectangle::module(js)},
+            {"glint:simd", simd::module(js)},
         },
 
     };
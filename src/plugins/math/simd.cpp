@@ -0,0 +1,211 @@
+#include <plugins/math.hpp>
+
+#include <array>
+#include <span>
+
+#include <fmt/format.h>
+#include <raylib.h>
+
+#include <simd.hpp>
+
+namespace glint::plugins::math::simd {
+
+using namespace gsl;
+using js::JSError;
+using js::JSResult;
+
+/// Float32Array of xy pairs, borrowed without copying
+static auto pairs_from_value(const js::Value& val) noexcept -> JSResult<std::span<float>> {
+    auto floats = js::try_into<std::span<float>>(val);
+    if (!floats) return floats;
+    if (floats->size() % 2 != 0) {
+        return Unexpected(
+            JSError::range_error(val.ctx(), fmt::format("Vector array length must be even, got {}", floats->size()))
+        );
+    }
+    return floats;
+}
+
+/// Second array of pairs, which must hold as many vectors as first one
+static auto matching_pairs_from_value(const js::Value& val, std::span<float> vectors) noexcept
+    -> JSResult<std::span<float>> {
+    auto other = pairs_from_value(val);
+    if (!other) return other;
+    if (other->size() != vectors.size()) {
+        return Unexpected(
+            JSError::range_error(
+                val.ctx(), fmt::format("Vector array lengths do not match: {} and {}", vectors.size(), other->size())
+            )
+        );
+    }
+    return other;
+}
+
+static auto add(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    if (argc < 2) return JS_ThrowRangeError(js, "Expected 2 arguments, got %d", argc);
+    const auto vectors = pairs_from_value(js::borrow(js, argv[0]));
+    if (!vectors) return jsthrow(vectors.error());
+
+    if (JS_GetTypedArrayType(argv[1]) >= 0) {
+        const auto offsets = matching_pairs_from_value(js::borrow(js, argv[1]), *vectors);
+        if (!offsets) return jsthrow(offsets.error());
+        glint::simd::add(*vectors, *offsets);
+    } else {
+        const auto offset = js::try_into<Vector2>(js::borrow(js, argv[1]));
+        if (!offset) return jsthrow(offset.error());
+        glint::simd::add(*vectors, *offset);
+    }
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto scale(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    if (argc < 2) return JS_ThrowRangeError(js, "Expected 2 arguments, got %d", argc);
+    const auto vectors = pairs_from_value(js::borrow(js, argv[0]));
+    if (!vectors) return jsthrow(vectors.error());
+
+    auto factor = Vector2 {};
+    if (JS_IsNumber(argv[1])) {
+        const auto f = js::try_into<float>(js::borrow(js, argv[1]));
+        if (!f) return jsthrow(f.error());
+        factor = Vector2 {.x = *f, .y = *f};
+    } else if (auto v = js::try_into<Vector2>(js::borrow(js, argv[1]))) {
+        factor = *v;
+    } else {
+        return jsthrow(v.error());
+    }
+    glint::simd::scale(*vectors, factor);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto mul_add(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue, JSValue, float>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value, deltas_value, factor] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+    const auto deltas = matching_pairs_from_value(js::borrow(js, deltas_value), *vectors);
+    if (!deltas) return jsthrow(deltas.error());
+
+    glint::simd::mul_add(*vectors, *deltas, factor);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto rotate(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue, float>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value, angle] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+
+    glint::simd::rotate(*vectors, angle);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto normalize(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+
+    glint::simd::normalize(*vectors);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto clamp(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue, Vector2, Vector2>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value, min, max] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+
+    glint::simd::clamp(*vectors, min, max);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto distance(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue, Vector2>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value, point] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+    const auto count = vectors->size() / 2;
+
+    // Output array is reused when given, so that distances can be computed every frame without allocating
+    auto out = JS_UNDEFINED;
+    if (argc >= 3 && !JS_IsUndefined(argv[2])) {
+        out = JS_DupValue(js, argv[2]);
+    } else {
+        auto length = JS_NewInt64(js, int64_t(count));
+        out = JS_NewTypedArray(js, 1, &length, JS_TYPED_ARRAY_FLOAT32);
+        if (JS_IsException(out)) return out;
+    }
+
+    const auto distances = js::try_into<std::span<float>>(js::borrow(js, out));
+    if (!distances) {
+        JS_FreeValue(js, out);
+        return jsthrow(distances.error());
+    }
+    if (distances->size() != count) {
+        JS_FreeValue(js, out);
+        return JS_ThrowRangeError(js, "Expected output of %zu distances, got %zu", count, distances->size());
+    }
+
+    glint::simd::distance(*vectors, point, *distances);
+    return out;
+}
+
+static auto lerp(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    const auto args = js::unpack_args<JSValue, JSValue, float>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [vectors_value, targets_value, amount] = *args;
+
+    const auto vectors = pairs_from_value(js::borrow(js, vectors_value));
+    if (!vectors) return jsthrow(vectors.error());
+    const auto targets = matching_pairs_from_value(js::borrow(js, targets_value), *vectors);
+    if (!targets) return jsthrow(targets.error());
+
+    glint::simd::lerp(*vectors, *targets, amount);
+    return JS_DupValue(js, argv[0]);
+}
+
+static auto get_instruction_set(JSContext *js, JSValueConst) -> JSValue {
+    return JS_NewString(js, glint::simd::instruction_set());
+}
+
+static const auto FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("add", 2, add),
+    JSCFunctionListEntry JS_CFUNC_DEF("scale", 2, scale),
+    JSCFunctionListEntry JS_CFUNC_DEF("mulAdd", 3, mul_add),
+    JSCFunctionListEntry JS_CFUNC_DEF("rotate", 2, rotate),
+    JSCFunctionListEntry JS_CFUNC_DEF("normalize", 1, normalize),
+    JSCFunctionListEntry JS_CFUNC_DEF("clamp", 3, clamp),
+    JSCFunctionListEntry JS_CFUNC_DEF("distance", 2, distance),
+    JSCFunctionListEntry JS_CFUNC_DEF("lerp", 3, lerp),
+    JSCFunctionListEntry JS_CGETSET_DEF("instructionSet", get_instruction_set, nullptr),
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:simd", [](auto js, auto m) -> int {
+        auto o = JS_NewObject(js);
+
+        JS_SetPropertyFunctionList(js, o, FUNCS.data(), int {FUNCS.size()});
+
+        JS_SetModuleExport(js, m, "simd", JS_DupValue(js, o));
+        JS_SetModuleExport(js, m, "default", o);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "simd");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+} // namespace glint::plugins::math::simd
@@ -0,0 +1,2 @@
+#include "./profiler/descriptor.cpp"
+#include "./profiler/module.cpp"
@@ -0,0 +1,12 @@
+#include <plugins/profiler.hpp>
+
+namespace glint::plugins::profiler {
+
+auto plugin(JSContext *js) -> EnginePlugin {
+    return EnginePlugin {
+        .name = "profiler",
+        .c_modules = {{"glint:profiler", module(js)}},
+    };
+}
+
+} // namespace glint::plugins::profiler
@@ -0,0 +1,65 @@
+#include <plugins/profiler.hpp>
+
+#include <array>
+
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <profiler.hpp>
+
+namespace glint::plugins::profiler {
+
+using namespace gsl;
+
+static auto begin(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("profiler.begin/{}", argc);
+    // Name is not even converted when profiler is disabled, so zones can stay in shipped game code
+    if (!glint::profiler::enabled()) return JS_UNDEFINED;
+    const auto args = js::unpack_args<std::string>(js, argc, argv);
+    if (!args) return jsthrow(args.error());
+    const auto [name] = *args;
+
+    try {
+        glint::profiler::begin(glint::profiler::intern(name));
+    } catch (std::exception& e) {
+        return JS_ThrowInternalError(js, "Could not begin profiler zone: %s", e.what());
+    }
+    return JS_UNDEFINED;
+}
+
+static auto end(JSContext *js, JSValueConst, int argc, JSValueConst *) -> JSValue {
+    GLINT_TRACE_BINDING("profiler.end/{}", argc);
+    if (!glint::profiler::enabled()) return JS_UNDEFINED;
+    if (!glint::profiler::end()) return JS_ThrowRangeError(js, "profiler.end called without matching profiler.begin");
+    return JS_UNDEFINED;
+}
+
+static auto get_enabled(JSContext *js, JSValueConst) -> JSValue {
+    return JS_NewBool(js, glint::profiler::enabled());
+}
+
+static const auto FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("begin", 1, begin),
+    JSCFunctionListEntry JS_CFUNC_DEF("end", 0, end),
+    JSCFunctionListEntry JS_CGETSET_DEF("enabled", get_enabled, nullptr),
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:profiler", [](auto js, auto m) -> int {
+        auto o = JS_NewObject(js);
+
+        JS_SetPropertyFunctionList(js, o, FUNCS.data(), int {FUNCS.size()});
+
+        JS_SetModuleExport(js, m, "profiler", JS_DupValue(js, o));
+        JS_SetModuleExport(js, m, "default", o);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "profiler");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+} // namespace glint::plugins::profiler
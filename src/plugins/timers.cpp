@@ -0,0 +1,2 @@
+#include "./timers/descriptor.cpp"
+#include "./timers/module.cpp"
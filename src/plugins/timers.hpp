@@ -0,0 +1,11 @@
+#pragma once
+
+#include <engine/plugin.hpp>
+#include <quickjs.hpp>
+
+namespace glint::plugins::timers {
+
+auto module(JSContext *js) -> JSModuleDef *;
+auto plugin(JSContext *js) -> EnginePlugin;
+
+} // namespace glint::plugins::timers
@@ -0,0 +1,12 @@
+#include <plugins/timers.hpp>
+
+namespace glint::plugins::timers {
+
+auto plugin(JSContext *js) -> EnginePlugin {
+    return EnginePlugin {
+        .name = "timers",
+        .c_modules = {{"glint:timers", module(js)}},
+    };
+}
+
+} // namespace glint::plugins::timers
@@ -0,0 +1,109 @@
+#include <plugins/timers.hpp>
+
+#include <array>
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include <binding_trace.hpp>
+#include <engine.hpp>
+
+namespace glint::plugins::timers {
+
+using namespace gsl;
+
+/// Callback argument is stored past the call, so it is owned, not borrowed like in `unpack_args`
+static auto read_callback(JSContext *js, int argc, JSValueConst *argv) -> js::JSResult<js::Function> {
+    if (argc < 1) return Unexpected(js::JSError::range_error(js, "Expected callback argument"));
+    return js::Function::from_value(js::own(js, JS_DupValue(js, argv[0])));
+}
+
+/// Delay in milliseconds, missing delay fires on next frame
+static auto read_delay(JSContext *js, int argc, JSValueConst *argv, int index) -> js::JSResult<double> {
+    if (argc <= index || JS_IsUndefined(argv[index])) return 0.0;
+    auto ms = js::try_into<double>(js::borrow(js, argv[index]));
+    if (!ms) return Unexpected(ms.error());
+    if (*ms < 0.0 || std::isnan(*ms)) return 0.0;
+    return *ms;
+}
+
+static auto deadline(JSContext *js, double ms) -> double {
+    return Engine::get(js).frame().time + ms / 1000.0;
+}
+
+static auto set_timeout(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("timers.setTimeout/{}", argc);
+    auto callback = read_callback(js, argc, argv);
+    if (!callback) return jsthrow(callback.error());
+    auto ms = read_delay(js, argc, argv, 1);
+    if (!ms) return jsthrow(ms.error());
+
+    const auto id = Engine::get(js).timers().set_timeout(std::move(*callback), deadline(js, *ms));
+    return JS_NewUint32(js, id);
+}
+
+static auto request_frame(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("timers.requestFrame/{}", argc);
+    auto callback = read_callback(js, argc, argv);
+    if (!callback) return jsthrow(callback.error());
+
+    const auto id = Engine::get(js).timers().request_frame(std::move(*callback));
+    return JS_NewUint32(js, id);
+}
+
+static auto cancel(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("timers.cancel/{}", argc);
+    // Like in browsers, clearing invalid id is not an error
+    if (argc < 1 || !JS_IsNumber(argv[0])) return JS_UNDEFINED;
+    auto id = js::try_into<uint32_t>(js::borrow(js, argv[0]));
+    if (id) Engine::get(js).timers().cancel(*id);
+    return JS_UNDEFINED;
+}
+
+static auto delay(JSContext *js, JSValueConst, int argc, JSValueConst *argv) -> JSValue {
+    GLINT_TRACE_BINDING("timers.delay/{}", argc);
+    auto ms = read_delay(js, argc, argv, 0);
+    if (!ms) return jsthrow(ms.error());
+
+    auto funcs = std::array<JSValue, 2> {};
+    auto promise = JS_NewPromiseCapability(js, funcs.data());
+    if (JS_IsException(promise)) return promise;
+    JS_FreeValue(js, funcs[1]);
+
+    // Resolving function is called by timer directly, no wrapper closure is needed
+    auto resolve = js::Function::from_value(js::own(js, funcs[0]));
+    if (!resolve) {
+        JS_FreeValue(js, promise);
+        return jsthrow(resolve.error());
+    }
+    (void)Engine::get(js).timers().set_timeout(std::move(*resolve), deadline(js, *ms));
+    return promise;
+}
+
+static const auto FUNCS = std::array {
+    JSCFunctionListEntry JS_CFUNC_DEF("setTimeout", 2, set_timeout),
+    JSCFunctionListEntry JS_CFUNC_DEF("clearTimeout", 1, cancel),
+    JSCFunctionListEntry JS_CFUNC_DEF("requestFrame", 1, request_frame),
+    JSCFunctionListEntry JS_CFUNC_DEF("cancelFrame", 1, cancel),
+    JSCFunctionListEntry JS_CFUNC_DEF("delay", 1, delay),
+};
+
+auto module(JSContext *js) -> JSModuleDef * {
+    auto m = JS_NewCModule(js, "glint:timers", [](auto js, auto m) -> int {
+        auto o = JS_NewObject(js);
+
+        JS_SetPropertyFunctionList(js, o, FUNCS.data(), int {FUNCS.size()});
+
+        JS_SetModuleExport(js, m, "timers", JS_DupValue(js, o));
+        JS_SetModuleExport(js, m, "default", o);
+
+        return 0;
+    });
+
+    JS_AddModuleExport(js, m, "timers");
+    JS_AddModuleExport(js, m, "default");
+
+    return m;
+}
+
+} // namespace glint::plugins::timers
@@ -5,27 +5,34 @@
 #include <quickjs.h>
 #include <raylib.h>
 
+#include <engine.hpp>
+
 namespace glint::plugins::window {
 
 static auto get_dt(::JSContext *js, ::JSValueConst) -> ::JSValue {
-    return ::JS_NewFloat64(js, static_cast<double>(::GetFrameTime()));
+    return ::JS_NewFloat64(js, Engine::get(js).frame().dt);
 }
 
 static auto get_time(::JSContext *js, ::JSValueConst) -> ::JSValue {
-    return ::JS_NewFloat64(js, static_cast<double>(::GetTime()));
+    return ::JS_NewFloat64(js, Engine::get(js).frame().time);
+}
+
+static auto get_alpha(::JSContext *js, ::JSValueConst) -> ::JSValue {
+    return ::JS_NewFloat64(js, Engine::get(js).frame().alpha);
 }
 
 static auto get_width(::JSContext *js, ::JSValueConst) -> ::JSValue {
-    return ::JS_NewFloat64(js, double(::GetScreenWidth()));
+    return ::JS_NewFloat64(js, double(Engine::get(js).frame().width));
 }
 
 static auto get_height(::JSContext *js, ::JSValueConst) -> ::JSValue {
-    return ::JS_NewFloat64(js, double(::GetScreenHeight()));
+    return ::JS_NewFloat64(js, double(Engine::get(js).frame().height));
 }
 
 const static auto funcs = std::array{
     ::JSCFunctionListEntry JS_CGETSET_DEF("dt", get_dt, nullptr),
     ::JSCFunctionListEntry JS_CGETSET_DEF("time", get_time, nullptr),
+    ::JSCFunctionListEntry JS_CGETSET_DEF("alpha", get_alpha, nullptr),
     ::JSCFunctionListEntry JS_CGETSET_DEF("width", get_width, nullptr),
     ::JSCFunctionListEntry JS_CGETSET_DEF("height", get_height, nullptr),
 };
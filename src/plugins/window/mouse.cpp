@@ -118,10 +118,7 @@ static auto set_y(JSContext *js, JSValueConst, JSValueConst val) -> JSValue {
 }
 
 static auto get_position(JSContext *js, JSValueConst) -> JSValue {
-    auto obj = JS_NewObjectClass(js, js::class_id<&math::vector2::VECTOR2>(js));
-    auto vec = owner<Vector2 *>(new Vector2 {GetMousePosition()});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return math::vector2::create(js, GetMousePosition());
 }
 
 static auto set_position(JSContext *js, JSValueConst, JSValueConst val) -> JSValue {
@@ -132,10 +129,7 @@ static auto set_position(JSContext *js, JSValueConst, JSValueConst val) -> JSVal
 }
 
 static auto get_delta(JSContext *js, JSValueConst) -> JSValue {
-    auto obj = JS_NewObjectClass(js, js::class_id<&math::vector2::VECTOR2>(js));
-    auto vec = owner<Vector2 *>(new Vector2 {::GetMouseDelta()});
-    JS_SetOpaque(obj, vec);
-    return obj;
+    return math::vector2::create(js, ::GetMouseDelta());
 }
 
 static auto set_cursor(JSContext *js, JSValueConst, JSValueConst val) -> JSValue {
@@ -0,0 +1,251 @@
+#include <profiler.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace glint::profiler {
+
+using Clock = std::chrono::steady_clock;
+
+/// Ring slot guarded by sequence number, which is number of event in it plus one, or zero while it is being written.
+/// Fields are atomics too, so that reading slot while owning thread overwrites it is not a data race
+struct Slot {
+    std::atomic<uint64_t> sequence = 0;
+    std::atomic<const char *> name = nullptr;
+    std::atomic<const char *> detail = nullptr;
+    std::atomic<int64_t> start_ns = 0;
+    std::atomic<int64_t> duration_ns = 0;
+};
+
+/// Single-producer ring. Owning thread publishes events by bumping `written`, reader copies them and drops ones whose
+/// slot sequence changed while copying
+struct ThreadRing {
+    std::array<Slot, RING_CAPACITY> slots {};
+    std::atomic<uint64_t> written = 0;
+    uint32_t id = 0;
+    std::string name {};
+};
+
+struct OpenZone {
+    const char *name;
+    int64_t start;
+};
+
+struct Registry {
+    std::mutex mutex {};
+    std::vector<std::unique_ptr<ThreadRing>> rings {};
+    std::unordered_set<std::string> names {};
+};
+
+static auto registry() -> Registry& {
+    static auto r = Registry {};
+    return r;
+}
+
+static auto is_enabled = std::atomic<bool> {false};
+static auto epoch = Clock::time_point {};
+static thread_local auto local_ring = static_cast<ThreadRing *>(nullptr);
+static thread_local auto open_zones = std::vector<OpenZone> {};
+/// Zones opened over `MAX_OPEN_ZONES`, so that their `end` calls do not close outer zones
+static thread_local auto dropped_zones = size_t {};
+
+/// Ring of calling thread, registered on first use. Rings outlive their threads, so finished workers stay in trace
+static auto ring() -> ThreadRing& {
+    if (local_ring != nullptr) return *local_ring;
+    auto& r = registry();
+    auto lock = std::lock_guard {r.mutex};
+    auto& ring = r.rings.emplace_back(std::make_unique<ThreadRing>());
+    ring->id = uint32_t(r.rings.size());
+    ring->name = fmt::format("Thread {}", ring->id);
+    local_ring = ring.get();
+    return *ring;
+}
+
+auto enable() noexcept -> void {
+    if (is_enabled.load(std::memory_order_relaxed)) return;
+    epoch = Clock::now();
+    is_enabled.store(true, std::memory_order_release);
+    SPDLOG_INFO("Profiler enabled, keeping last {} zones per thread", RING_CAPACITY);
+}
+
+auto enabled() noexcept -> bool {
+    return is_enabled.load(std::memory_order_acquire);
+}
+
+auto now() noexcept -> int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+auto intern(std::string_view name) -> const char * {
+    auto& r = registry();
+    auto lock = std::lock_guard {r.mutex};
+    return r.names.emplace(name).first->c_str();
+}
+
+auto record(const Event& event) noexcept -> void try {
+    auto& r = ring();
+    const auto index = r.written.load(std::memory_order_relaxed);
+    auto& slot = r.slots[index % RING_CAPACITY];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.detail.store(event.detail, std::memory_order_relaxed);
+    slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(event.duration_ns, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    r.written.store(index + 1, std::memory_order_release);
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not record profiler zone: {}", e.what());
+}
+
+auto name_thread(std::string_view name) noexcept -> void try {
+    // Ring is not allocated for threads of game that is not profiled
+    if (!enabled()) return;
+    auto& thread_ring = ring();
+    auto lock = std::lock_guard {registry().mutex};
+    thread_ring.name = name;
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not name profiler thread: {}", e.what());
+}
+
+auto begin(const char *name) noexcept -> void try {
+    if (!enabled()) return;
+    if (open_zones.size() >= MAX_OPEN_ZONES) {
+        dropped_zones++;
+        return;
+    }
+    open_zones.push_back({.name = name, .start = now()});
+} catch (std::exception& e) {
+    SPDLOG_WARN("Could not begin profiler zone: {}", e.what());
+}
+
+auto end() noexcept -> bool {
+    if (dropped_zones > 0) {
+        dropped_zones--;
+        return true;
+    }
+    if (open_zones.empty()) return false;
+    const auto zone = open_zones.back();
+    open_zones.pop_back();
+    record({.name = zone.name, .detail = nullptr, .start_ns = zone.start, .duration_ns = now() - zone.start});
+    return true;
+}
+
+auto close_open_zones() noexcept -> void {
+    if (open_zones.empty() && dropped_zones == 0) return;
+    SPDLOG_DEBUG("Closing {} profiler zones left open", open_zones.size() + dropped_zones);
+    dropped_zones = 0;
+    while (end()) {}
+}
+
+static auto json_string(std::string_view str) -> std::string {
+    auto out = std::string {"\""};
+    for (const auto c : str) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) out += fmt::format("\\u{:04x}", int(c));
+                else out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+/// Events of ring, oldest first, that were not overwritten while being copied
+static auto snapshot(const ThreadRing& ring) -> std::vector<Event> {
+    const auto written = ring.written.load(std::memory_order_acquire);
+    const auto first = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+    auto events = std::vector<Event> {};
+    events.reserve(size_t(written - first));
+    for (auto i = first; i < written; i++) {
+        const auto& slot = ring.slots[i % RING_CAPACITY];
+        // Slot already holds later event, or is being overwritten by it
+        if (slot.sequence.load(std::memory_order_acquire) != i + 1) continue;
+        const auto event = Event {
+            .name = slot.name.load(std::memory_order_relaxed),
+            .detail = slot.detail.load(std::memory_order_relaxed),
+            .start_ns = slot.start_ns.load(std::memory_order_relaxed),
+            .duration_ns = slot.duration_ns.load(std::memory_order_relaxed),
+        };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != i + 1) continue;
+        events.push_back(event);
+    }
+    return events;
+}
+
+auto write_trace(const std::filesystem::path& path) noexcept -> Result<> try {
+    auto file = std::ofstream {path, std::ios::binary | std::ios::trunc};
+    if (!file) return err(fmt::format("Could not open {} for writing", path.string()));
+
+    auto& r = registry();
+    auto lock = std::lock_guard {r.mutex};
+    auto count = size_t {};
+    auto separator = "";
+    file << R"({"displayTimeUnit":"ms","traceEvents":[)" << '\n';
+    for (const auto& ring : r.rings) {
+        file << separator
+             << fmt::format(
+                    R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":{}}}}})",
+                    ring->id,
+                    json_string(ring->name)
+                );
+        separator = ",\n";
+
+        for (const auto& event : snapshot(*ring)) {
+            file << separator
+                 << fmt::format(
+                        R"({{"name":{},"cat":"glint","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})",
+                        json_string(event.name),
+                        ring->id,
+                        double(event.start_ns) / 1000.0,
+                        double(event.duration_ns) / 1000.0
+                    );
+            if (event.detail != nullptr) file << R"(,"args":{"detail":)" << json_string(event.detail) << '}';
+            file << '}';
+            count++;
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file) return err(fmt::format("Could not write trace to {}", path.string()));
+    SPDLOG_INFO("Wrote {} profiler zones to {}", count, path.string());
+    return {};
+} catch (std::exception& e) {
+    return err(e);
+}
+
+Zone::Zone(const char *name) noexcept : _name {name} {
+    if (enabled()) _start = now();
+}
+
+Zone::Zone(const char *name, std::string_view detail) noexcept : _name {name} {
+    if (!enabled()) return;
+    try {
+        _detail = intern(detail);
+    } catch (...) {
+        _detail = nullptr;
+    }
+    _start = now();
+}
+
+Zone::~Zone() noexcept {
+    if (_start < 0) return;
+    record({.name = _name, .detail = _detail, .start_ns = _start, .duration_ns = now() - _start});
+}
+
+} // namespace glint::profiler
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include <error.hpp>
+
+/// Scoped-zone frame profiler. Zones are recorded into per-thread rings only after `enable`, so disabled zones cost
+/// one atomic load. Recorded zones are written as Chrome `trace_event` JSON, viewable in Perfetto or chrome://tracing
+namespace glint::profiler {
+
+/// Zones kept per thread, older ones are overwritten
+constexpr size_t RING_CAPACITY = size_t {1} << 15;
+
+/// Nesting depth of zones opened by `begin`, deeper ones are not recorded
+constexpr size_t MAX_OPEN_ZONES = 256;
+
+struct Event {
+    /// String literal or result of `intern`
+    const char *name;
+    /// Result of `intern` or null
+    const char *detail;
+    int64_t start_ns;
+    int64_t duration_ns;
+};
+
+/// Start recording zones. Times are measured from this call
+auto enable() noexcept -> void;
+
+[[nodiscard]]
+auto enabled() noexcept -> bool;
+
+/// Nanoseconds since `enable`
+[[nodiscard]]
+auto now() noexcept -> int64_t;
+
+/// Copy of string living until program exit, for zone names that are not literals
+[[nodiscard]]
+auto intern(std::string_view name) -> const char *;
+
+/// Push finished zone into ring of calling thread. Only that thread writes to it, so no lock is taken
+auto record(const Event& event) noexcept -> void;
+
+/// Name of calling thread shown in trace. Does nothing until profiler is enabled
+auto name_thread(std::string_view name) noexcept -> void;
+
+/// Open zone on calling thread, closed by matching `end`. For zones that do not follow C++ scopes, like JS ones
+auto begin(const char *name) noexcept -> void;
+
+/// Close innermost zone opened by `begin`. Returns false when there is none
+auto end() noexcept -> bool;
+
+/// Close zones opened by `begin` on calling thread that are still open, so that zones never ended do not pile up.
+/// Called at end of every frame
+auto close_open_zones() noexcept -> void;
+
+/// Write zones still in rings of all threads as Chrome trace JSON
+[[nodiscard]]
+auto write_trace(const std::filesystem::path& path) noexcept -> Result<>;
+
+/// Zone lasting until end of scope
+class Zone {
+  private:
+    const char *_name;
+    const char *_detail = nullptr;
+    /// Negative when profiler was disabled on creation
+    int64_t _start = -1;
+
+  public:
+    explicit Zone(const char *name) noexcept;
+
+    /// `detail`, like module or asset name, is interned only when profiler is enabled
+    Zone(const char *name, std::string_view detail) noexcept;
+
+    Zone(const Zone&) = delete;
+    Zone(Zone&&) = delete;
+    auto operator=(const Zone&) -> Zone& = delete;
+    auto operator=(Zone&&) -> Zone& = delete;
+    ~Zone() noexcept;
+};
+
+} // namespace glint::profiler
@@ -1,10 +1,31 @@
 #include <quickjs.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <utility>
+#include <vector>
 
 namespace glint::js {
 
+static constexpr auto ATOM_NAMES = std::array<czstring, size_t(Atom::count_)> {
+#define glint_JS_ATOM_NAME(name) #name,
+    glint_JS_ATOMS(glint_JS_ATOM_NAME)
+#undef glint_JS_ATOM_NAME
+};
+
+AtomTable::AtomTable(not_null<JSContext *> js) noexcept : _rt(JS_GetRuntime(js)) {
+    for (size_t i = 0; i < _atoms.size(); i++) {
+        _atoms[i] = JS_NewAtom(js, ATOM_NAMES[i]);
+    }
+}
+
+AtomTable::~AtomTable() noexcept {
+    for (const auto atom : _atoms) {
+        JS_FreeAtomRT(_rt, atom);
+    }
+}
+
 Value::Owned::Owned(not_null<JSContext *> js, JSValue value) noexcept : _ctx(js), _value(value) {};
 
 Value::Owned::~Owned() noexcept {
@@ -86,19 +107,29 @@ auto Function::from_value(Value value) noexcept -> JSResult<Function> {
 }
 
 auto Function::operator()() noexcept -> JSResult<Value> {
-    return this->operator()(JS_UNDEFINED, {});
+    return call_raw(JS_UNDEFINED, 0, nullptr);
 }
 
 auto Function::operator()(std::span<Value> args) noexcept -> JSResult<Value> {
     return this->operator()(JS_UNDEFINED, args);
 }
 
-auto Function::operator()(JSValueConst this_value, std::span<Value> args) noexcept -> JSResult<Value> {
-    auto argv = std::make_unique<JSValue[]>(args.size());
-    for (size_t i = 0; i < args.size(); i++) {
-        argv[i] = args[i].cget();
+auto Function::operator()(JSValueConst this_value, std::span<Value> args) noexcept -> JSResult<Value> try {
+    if (args.size() <= INLINE_ARGS) {
+        auto argv = std::array<JSValue, INLINE_ARGS> {};
+        std::ranges::transform(args, argv.begin(), [](const Value& v) { return v.cget(); });
+        return call_raw(this_value, int(args.size()), argv.data());
     }
-    auto val = JS_Call(_value.ctx(), _value.cget(), this_value, int(args.size()), argv.get());
+
+    auto argv = std::vector<JSValue>(args.size());
+    std::ranges::transform(args, argv.begin(), [](const Value& v) { return v.cget(); });
+    return call_raw(this_value, int(argv.size()), argv.data());
+} catch (std::bad_alloc&) {
+    return Unexpected(JSError::plain_error(_value.ctx(), "Out of memory while calling function"));
+}
+
+auto Function::call_raw(JSValueConst this_value, int argc, JSValueConst *argv) noexcept -> JSResult<Value> {
+    auto val = JS_Call(_value.ctx(), _value.cget(), this_value, argc, argv);
     if (JS_HasException(_value.ctx())) {
         // TODO: Is it really borrowed? Do we need to free exception?
         auto ex = Value::borrowed(_value.ctx(), JS_GetException(_value.ctx()));
@@ -213,6 +244,48 @@ auto JSError::stack() const noexcept -> std::optional<std::string> try {
     return std::nullopt;
 }
 
+auto Promise::create(not_null<JSContext *> ctx) noexcept -> JSResult<Promise> {
+    auto funcs = std::array<JSValue, 2> {JS_UNDEFINED, JS_UNDEFINED};
+    auto promise = JS_NewPromiseCapability(ctx, funcs.data());
+    if (JS_IsException(promise)) return Unexpected(JSError::from_value(own(ctx, JS_GetException(ctx))));
+
+    auto resolve = Function::from_value(own(ctx, funcs[0]));
+    if (!resolve) return Unexpected(resolve.error());
+    auto reject = Function::from_value(own(ctx, funcs[1]));
+    if (!reject) return Unexpected(reject.error());
+
+    return Promise(own(ctx, promise), std::move(*resolve), std::move(*reject));
+}
+
+auto Promise::ctx() const noexcept -> not_null<JSContext *> {
+    return _promise.ctx();
+}
+
+auto Promise::object() const noexcept -> JSValue {
+    return JS_DupValue(_promise.ctx(), _promise.cget());
+}
+
+auto Promise::resolve(const Value& value) noexcept -> void {
+    if (auto r = _resolve.call(JS_UNDEFINED, value); !r) {
+        SPDLOG_WARN("Could not resolve promise: {}", r.error().msg());
+    }
+}
+
+auto Promise::reject(const Value& reason) noexcept -> void {
+    if (auto r = _reject.call(JS_UNDEFINED, reason); !r) {
+        SPDLOG_WARN("Could not reject promise: {}", r.error().msg());
+    }
+}
+
+auto Promise::reject(JSError error) noexcept -> void {
+    reject(error.get().get());
+}
+
+Promise::Promise(Value&& promise, Function&& resolve, Function&& reject) noexcept :
+    _promise(std::move(promise)),
+    _resolve(std::move(resolve)),
+    _reject(std::move(reject)) {}
+
 auto borrow(not_null<JSContext *> ctx, JSValue val) noexcept -> Value {
     return Value::borrowed(ctx, val);
 }
@@ -281,6 +354,45 @@ auto display_type(const Value& val) -> czstring {
     return display_type(val.cget().tag);
 }
 
+static auto typed_array_name(JSTypedArrayEnum type) -> czstring {
+    switch (type) {
+        case JS_TYPED_ARRAY_UINT8:
+            return "Uint8Array";
+        case JS_TYPED_ARRAY_INT32:
+            return "Int32Array";
+        case JS_TYPED_ARRAY_FLOAT32:
+            return "Float32Array";
+        default:
+            return "TypedArray";
+    }
+}
+
+auto typed_array_bytes(const Value& v, JSTypedArrayEnum type) noexcept -> JSResult<std::span<uint8_t>> {
+    // Clamping only matters on writes, so Uint8ClampedArray is read as Uint8Array
+    const auto actual = JS_GetTypedArrayType(v.cget());
+    if (actual != int {type} && !(type == JS_TYPED_ARRAY_UINT8 && actual == JS_TYPED_ARRAY_UINT8C)) {
+        return Unexpected(
+            JSError::type_error(
+                v.ctx(), fmt::format("Value of type `{}` is not a {}", display_type(v), typed_array_name(type))
+            )
+        );
+    }
+
+    auto offset = size_t {};
+    auto length = size_t {};
+    auto bytes_per_element = size_t {};
+    auto buffer = JS_GetTypedArrayBuffer(v.ctx(), v.cget(), &offset, &length, &bytes_per_element);
+    if (JS_IsException(buffer)) return Unexpected(JSError::from_value(own(v.ctx(), JS_GetException(v.ctx()))));
+    defer(JS_FreeValue(v.ctx(), buffer));
+
+    auto size = size_t {};
+    const auto bytes = JS_GetArrayBuffer(v.ctx(), &size, buffer);
+    if (bytes == nullptr) {
+        return Unexpected(JSError::type_error(v.ctx(), fmt::format("{} buffer is detached", typed_array_name(type))));
+    }
+    return std::span(bytes + offset, length);
+}
+
 } // namespace glint::js
 
 namespace glint {
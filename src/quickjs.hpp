@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <expected>
 #include <optional>
 #include <span>
@@ -42,11 +44,73 @@ concept is_optional = requires(T a, typename T::value_type v) {
     requires std::is_constructible_v<T, typename T::value_type>;
 };
 
+/// Typed array that `std::span<T>` or `std::span<const T>` borrows
+template<typename T>
+struct typed_array {};
+
+template<>
+struct typed_array<float> {
+    static constexpr auto type = JS_TYPED_ARRAY_FLOAT32;
+};
+
+template<>
+struct typed_array<int32_t> {
+    static constexpr auto type = JS_TYPED_ARRAY_INT32;
+};
+
+template<>
+struct typed_array<uint8_t> {
+    static constexpr auto type = JS_TYPED_ARRAY_UINT8;
+};
+
+template<typename T>
+concept is_typed_array_element = requires { typed_array<T>::type; };
+
+template<typename T>
+concept is_typed_array_span = requires { typename T::element_type; }
+    && std::same_as<T, std::span<typename T::element_type>>
+    && is_typed_array_element<std::remove_const_t<typename T::element_type>>;
+
 class Value;
 class Function;
 class Object;
 class JSError;
 
+// Property names read by native conversions on hot paths. Atoms for them are created once per runtime, see `AtomTable`
+#define glint_JS_ATOMS(X)                                                                                              \
+    X(x) X(y) X(width) X(height)                                                                                       \
+    X(r) X(g) X(b) X(a)                                                                                                \
+    X(offset) X(target) X(rotation) X(zoom)                                                                            \
+    X(text) X(codepoint) X(codepoints) X(fontSize) X(position) X(color) X(origin) X(spacing) X(font)                   \
+    X(source) X(left) X(top) X(right) X(bottom) X(layout)
+
+enum class Atom : uint8_t {
+#define glint_JS_ATOM_ENUM(name) name,
+    glint_JS_ATOMS(glint_JS_ATOM_ENUM)
+#undef glint_JS_ATOM_ENUM
+        count_,
+};
+
+/// Interned property names for `Object::at(JSAtom)`, so lookups do no string hashing
+class AtomTable {
+  private:
+    JSRuntime *_rt;
+    std::array<JSAtom, size_t(Atom::count_)> _atoms {};
+
+  public:
+    explicit AtomTable(not_null<JSContext *> js) noexcept;
+    ~AtomTable() noexcept;
+    AtomTable(const AtomTable&) = delete;
+    AtomTable(AtomTable&&) = delete;
+    auto operator=(const AtomTable&) -> AtomTable& = delete;
+    auto operator=(AtomTable&&) -> AtomTable& = delete;
+
+    [[nodiscard]]
+    auto operator[](Atom atom) const noexcept -> JSAtom {
+        return _atoms[size_t(atom)];
+    }
+};
+
 template<typename T = std::monostate>
 using JSResult = Result<T, JSError>;
 
@@ -111,14 +175,24 @@ class Function {
     Value _value;
 
   public:
+    /// Calls with at most this many arguments pass them through stack storage
+    static constexpr size_t INLINE_ARGS = 8;
+
     static auto from_value(Value value) noexcept -> JSResult<Function>;
 
     auto operator()() noexcept -> JSResult<Value>;
     auto operator()(std::span<Value> args) noexcept -> JSResult<Value>;
     auto operator()(JSValueConst this_value, std::span<Value> args) noexcept -> JSResult<Value>;
 
+    /// Call with arguments known at compile time. Argument array lives on stack
+    template<typename... Args>
+        requires(std::same_as<Args, Value> && ...)
+    auto call(JSValueConst this_value, const Args&...args) noexcept -> JSResult<Value>;
+
   private:
     Function(Value&& value) noexcept;
+
+    auto call_raw(JSValueConst this_value, int argc, JSValueConst *argv) noexcept -> JSResult<Value>;
 };
 
 class Object {
@@ -142,6 +216,10 @@ class Object {
     [[nodiscard]]
     auto at(const std::string& prop) const noexcept -> JSResult<T>;
 
+    template<typename T>
+    [[nodiscard]]
+    auto at(JSAtom prop) const noexcept -> JSResult<T>;
+
   private:
     Object(Value&& value) noexcept;
 };
@@ -205,6 +283,32 @@ class JSError: public glint::error::IError {
     auto stack() const noexcept -> std::optional<std::string>;
 };
 
+/// Promise settled later by native code, e.g. when work on another thread is done
+class Promise {
+  private:
+    Value _promise;
+    Function _resolve;
+    Function _reject;
+
+  public:
+    static auto create(not_null<JSContext *> ctx) noexcept -> JSResult<Promise>;
+
+    [[nodiscard]]
+    auto ctx() const noexcept -> not_null<JSContext *>;
+
+    /// New reference to promise object, suitable for returning from binding
+    [[nodiscard]]
+    auto object() const noexcept -> JSValue;
+
+    /// Errors thrown by resolving functions are logged, promise reactions run with pending jobs
+    auto resolve(const Value& value) noexcept -> void;
+    auto reject(const Value& reason) noexcept -> void;
+    auto reject(JSError error) noexcept -> void;
+
+  private:
+    Promise(Value&& promise, Function&& resolve, Function&& reject) noexcept;
+};
+
 auto borrow(not_null<JSContext *> ctx, JSValue val) noexcept -> Value;
 
 auto own(not_null<JSContext *> ctx, JSValue val) noexcept -> Value;
@@ -231,6 +335,10 @@ auto display_type(JSValueConst val) -> czstring;
 
 auto display_type(const Value& val) -> czstring;
 
+/// Backing store of typed array of `type` without copying it, writes are seen by JS. Valid only while array is alive
+/// and its buffer is not detached or resized, so it must not outlive binding call it was passed to
+auto typed_array_bytes(const Value& v, JSTypedArrayEnum type) noexcept -> JSResult<std::span<uint8_t>>;
+
 } // namespace glint::js
 
 namespace glint {
@@ -250,6 +358,17 @@ auto err(const js::JSResult<T>& r) noexcept -> Unexpected<Error>;
 
 namespace glint::js {
 
+template<typename... Args>
+    requires(std::same_as<Args, Value> && ...)
+auto Function::call(JSValueConst this_value, const Args&...args) noexcept -> JSResult<Value> {
+    if constexpr (sizeof...(Args) == 0) {
+        return call_raw(this_value, 0, nullptr);
+    } else {
+        auto argv = std::array<JSValue, sizeof...(Args)> {args.cget()...};
+        return call_raw(this_value, int(argv.size()), argv.data());
+    }
+}
+
 template<typename T>
 auto Object::at(czstring name) const noexcept -> JSResult<T> {
     auto prop = Value::owned(_value.ctx(), JS_GetPropertyStr(_value.ctx(), _value.cget(), name));
@@ -261,6 +380,12 @@ auto Object::at(const std::string& name) const noexcept -> JSResult<T> {
     return at<T>(name.c_str());
 }
 
+template<typename T>
+auto Object::at(JSAtom prop) const noexcept -> JSResult<T> {
+    auto value = Value::owned(_value.ctx(), JS_GetProperty(_value.ctx(), _value.cget(), prop));
+    return try_into<T>(value);
+}
+
 template<auto T>
 auto class_id(not_null<JSContext *> js) -> JSClassID {
     return class_id<T>(JS_GetRuntime(js));
@@ -341,9 +466,29 @@ inline auto try_into(const Value& v) noexcept -> JSResult<T> {
     return static_cast<T>(*num);
 }
 
+template<typename T>
+    requires is_typed_array_span<T>
+inline auto try_into(const Value& v) noexcept -> JSResult<T> {
+    using Element = std::remove_const_t<typename T::element_type>;
+    const auto bytes = typed_array_bytes(v, typed_array<Element>::type);
+    if (!bytes) return Unexpected(bytes.error());
+    // NOLINTNEXTLINE: offset of typed array is multiple of its element size
+    return T(reinterpret_cast<Element *>(bytes->data()), bytes->size() / sizeof(Element));
+}
+
 template<typename T>
     requires is_container<T> && (!is_basic_string_v<T>)
 inline auto try_into(const Value& v) noexcept -> JSResult<T> try {
+    // Matching typed array is copied at once instead of getting its elements one by one
+    using Element = typename T::value_type;
+    if constexpr (is_typed_array_element<Element> && std::is_constructible_v<T, const Element *, const Element *>) {
+        if (JS_GetTypedArrayType(v.cget()) == typed_array<Element>::type) {
+            const auto elements = try_into<std::span<const Element>>(v);
+            if (!elements) return Unexpected(elements.error());
+            return T(elements->data(), elements->data() + elements->size());
+        }
+    }
+
     if (!JS_IsArray(v.cget())) {
         return Unexpected(
             JSError::type_error(v.ctx(), fmt::format("Value of type `{}` is not an Array", display_type(v)))
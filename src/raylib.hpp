@@ -3,6 +3,7 @@
 #include <gsl/gsl>
 #include <span>
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -137,11 +138,11 @@ class Image: public ::Image {
         return {::LoadImageAnim(file_name, frames)};
     }
 
-    static auto load_anim_from_memory(czstring file_type, std::span<unsigned char> data, int *frames) -> Image {
+    static auto load_anim_from_memory(czstring file_type, std::span<const unsigned char> data, int *frames) -> Image {
         return {::LoadImageAnimFromMemory(file_type, data.data(), int(data.size()), frames)};
     }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) -> Image {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) -> Image {
         return {::LoadImageFromMemory(file_type, data.data(), int(data.size()))};
     }
 
@@ -153,6 +154,15 @@ class Image: public ::Image {
         return {::LoadImageFromScreen()};
     }
 
+    /// Take ownership of image, which data must be allocated with `MemAlloc`
+    static auto adopt(::Image image) noexcept -> Image {
+        return {image};
+    }
+
+    static auto gen_color(int width, int height, ::Color color) noexcept -> Image {
+        return {::GenImageColor(width, height, color)};
+    }
+
     Image() noexcept : ::Image {} {}
 
     Image(const Image&) = delete;
@@ -172,7 +182,24 @@ class Image: public ::Image {
         ::UnloadImage(*this);
     }
 
+    /// Encode image into file format given by extension, like `.png`. Empty on failure
+    [[nodiscard]]
+    auto export_to_memory(czstring file_type) const -> std::vector<unsigned char> {
+        auto size = int {};
+        const auto data = ::ExportImageToMemory(*this, file_type, &size);
+        if (data == nullptr) return {};
+        auto bytes = std::vector<unsigned char>(data, data + size);
+        ::MemFree(data);
+        return bytes;
+    }
+
+    /// Convert pixel data to another format in place
+    auto convert(int pixel_format) noexcept -> void {
+        ::ImageFormat(this, pixel_format);
+    }
+
     friend inline auto swap(Image& a, Image& b) noexcept -> void;
+    friend class Font;
 
   private:
     Image(::Image img) noexcept : ::Image {img} {}
@@ -192,16 +219,26 @@ class Texture: public ::Texture {
         return {::LoadTexture(file_name)};
     }
 
-    static auto load_from_image(::Image image) noexcept -> Texture {
+    static auto load_from_image(const ::Image& image) noexcept -> Texture {
+        // No GPU context without window: keep only image metadata, UnloadTexture skips id 0
+        if (!::IsWindowReady()) {
+            return {::Texture {
+                .id = 0,
+                .width = image.width,
+                .height = image.height,
+                .mipmaps = image.mipmaps,
+                .format = image.format,
+            }};
+        }
         return {::LoadTextureFromImage(image)};
     }
 
-    static auto load_from_memory(czstring extension, std::span<unsigned char> data) noexcept -> Texture {
+    static auto load_from_memory(czstring extension, std::span<const unsigned char> data) noexcept -> Texture {
         const auto image = ::LoadImageFromMemory(extension, data.data(), int(data.size()));
         if (!::IsImageValid(image)) return {};
-        const auto texture = ::LoadTextureFromImage(image);
+        auto texture = load_from_image(image);
         ::UnloadImage(image);
-        return {texture};
+        return texture;
     }
 
     Texture() noexcept : ::Texture {} {}
@@ -240,6 +277,7 @@ class Texture: public ::Texture {
 class RenderTexture: public ::RenderTexture {
   public:
     static auto load(int width, int height) noexcept -> RenderTexture {
+        if (!::IsWindowReady()) return {};
         return {::LoadRenderTexture(width, height)};
     }
 
@@ -291,10 +329,12 @@ class Font: public ::Font {
 
     static auto load_from_memory(
         czstring file_type,
-        std::span<unsigned char> data,
+        std::span<const unsigned char> data,
         int font_size,
         std::optional<std::span<int>> codepoints
     ) noexcept -> Font {
+        // Font atlas is uploaded to GPU, which is not available without window
+        if (!::IsWindowReady()) return {};
         if (codepoints) {
             return {::LoadFontFromMemory(
                 file_type,
@@ -309,6 +349,54 @@ class Font: public ::Font {
         }
     }
 
+    /// CPU half of `LoadFontFromMemory` for TTF/OTF data: rasterizes glyphs and packs them into `atlas` without
+    /// touching GPU, so it can run on worker thread. Font has no texture until `upload_atlas`
+    static auto rasterize(
+        std::span<const unsigned char> data,
+        int font_size,
+        std::optional<std::span<int>> codepoints,
+        Image& atlas
+    ) noexcept -> Font {
+        // Same defaults as LoadFontFromMemory: printable ASCII and rtext.c FONT_TTF_DEFAULT_CHARS_PADDING
+        constexpr auto DEFAULT_GLYPH_COUNT = 95;
+        constexpr auto GLYPH_PADDING = 4;
+
+        const auto codepoint_count = codepoints ? int(codepoints->size()) : 0;
+        auto font = ::Font {};
+        font.baseSize = font_size;
+        font.glyphCount = codepoint_count > 0 ? codepoint_count : DEFAULT_GLYPH_COUNT;
+        font.glyphs = ::LoadFontData(
+            data.data(),
+            int(data.size()),
+            font_size,
+            codepoints ? codepoints->data() : nullptr,
+            codepoint_count,
+            FONT_DEFAULT
+        );
+        if (font.glyphs == nullptr) return {};
+
+        font.glyphPadding = GLYPH_PADDING;
+        atlas = Image {::GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font_size, GLYPH_PADDING, 0)};
+        // Glyph images have to match atlas for ImageDrawText
+        for (int i = 0; i < font.glyphCount; i++) {
+            ::UnloadImage(font.glyphs[i].image);
+            font.glyphs[i].image = ::ImageFromImage(atlas, font.recs[i]);
+        }
+        return {font};
+    }
+
+    /// Take ownership of font, which arrays must be allocated with `MemAlloc`
+    static auto adopt(::Font font) noexcept -> Font {
+        return {font};
+    }
+
+    /// Upload atlas produced by `rasterize` as font texture
+    auto upload_atlas(const ::Image& atlas) noexcept -> void {
+        // Font atlas is uploaded to GPU, which is not available without window
+        if (!::IsWindowReady()) return;
+        texture = ::LoadTextureFromImage(atlas);
+    }
+
     Font() noexcept : ::Font {} {}
 
     Font(const Font&) = delete;
@@ -349,7 +437,7 @@ class Wave: public ::Wave {
         return {::LoadWave(file_name)};
     }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) noexcept -> Wave {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) noexcept -> Wave {
         return {::LoadWaveFromMemory(file_type, data.data(), int(data.size()))};
     }
 
@@ -426,13 +514,53 @@ class Sound: public ::Sound {
     }
 };
 
+class AudioStream: public ::AudioStream {
+  public:
+    static auto load(unsigned int sample_rate, unsigned int sample_size, unsigned int channels) noexcept
+        -> AudioStream {
+        return {::LoadAudioStream(sample_rate, sample_size, channels)};
+    }
+
+    AudioStream() noexcept : ::AudioStream {} {}
+
+    AudioStream(const AudioStream&) = delete;
+
+    AudioStream(AudioStream&& other) noexcept : ::AudioStream {other} {
+        other.reset();
+    }
+
+    auto operator=(const AudioStream&) -> AudioStream& = delete;
+
+    auto operator=(AudioStream&& other) noexcept -> AudioStream& {
+        swap(*this, other);
+        return *this;
+    }
+
+    ~AudioStream() noexcept {
+        ::UnloadAudioStream(*this);
+    }
+
+    friend inline auto swap(AudioStream& a, AudioStream& b) noexcept -> void;
+
+  private:
+    AudioStream(::AudioStream stream) noexcept : ::AudioStream {stream} {}
+
+    auto reset() noexcept -> void {
+        buffer = {};
+        processor = {};
+        sampleRate = {};
+        sampleSize = {};
+        channels = {};
+    }
+};
+
 class Music: public ::Music {
   public:
     static auto load(czstring file_name) noexcept -> Music {
         return {::LoadMusicStream(file_name)};
     }
 
-    static auto load_from_memory(czstring file_type, std::span<unsigned char> data) noexcept -> Music {
+    static auto load_from_memory(czstring file_type, std::span<const unsigned char> data) noexcept -> Music {
         return {::LoadMusicStreamFromMemory(file_type, data.data(), int(data.size()))};
     }
 
@@ -525,6 +653,16 @@ inline auto swap(Sound& x, Sound& y) noexcept -> void {
     swap(x.frameCount, y.frameCount);
 }
 
+inline auto swap(AudioStream& x, AudioStream& y) noexcept -> void {
+    using std::swap;
+
+    swap(x.buffer, y.buffer);
+    swap(x.processor, y.processor);
+    swap(x.sampleRate, y.sampleRate);
+    swap(x.sampleSize, y.sampleSize);
+    swap(x.channels, y.channels);
+}
+
 inline auto swap(Music& x, Music& y) noexcept -> void {
     using std::swap;
 
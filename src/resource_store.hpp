@@ -1,11 +1,13 @@
 #pragma once
 
-#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
 #include <gsl/gsl>
-#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
@@ -16,115 +18,281 @@ namespace glint {
 using namespace gsl;
 
 template<typename T>
-concept is_data_v = requires(T d, T::data_type v) {
+concept is_data_v = requires(const T c, T d, T::data_type v) {
     typename T::data_type;
     { T {} } -> std::same_as<T>;
     { d.get() } -> std::same_as<typename T::data_type&>;
+    { c.size_bytes() } -> std::convertible_to<size_t>;
 };
 
-template<typename T>
-    requires is_data_v<T>
-struct Resource {
-    T data {};
-    std::atomic_int32_t ref_count {};
+struct ResourceStats {
+    /// Bytes of all loaded resources, referenced or not
+    size_t resident_bytes = 0;
+    size_t budget_bytes = 0;
+    size_t resident = 0;
+    /// Loaded resources nothing references, kept until budget is exceeded
+    size_t cached = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
 };
 
+/// Reference counted resources addressed by generation-tagged handles.
+/// Resources live in contiguous slots, handle lookup is one array index and a generation compare. Slot of released
+/// resource is reused with next generation, so stale handles resolve to default resource instead of a new one.
+/// References returned by `get` and `borrow` are invalidated by next `load`.
+/// Resources that are no longer referenced stay loaded and can be found by name, until memory of all resources goes
+/// over budget. Then least recently released ones are evicted, and their reload callbacks are kept, so that next
+/// `load_by_name` loads them again.
+/// Store is only used from main thread.
 template<typename T>
     requires is_data_v<T>
 class ResourceStore {
   public:
-    using Handle = int32_t;
+    /// Slot index in low `INDEX_BITS` bits, slot generation in the rest. Generations start at 1, so 0 is never valid
+    using Handle = uint32_t;
+    using Loader = std::function<auto()->T>;
+
+    static constexpr auto INDEX_BITS = 20u;
+    static constexpr auto INDEX_MASK = (Handle {1} << INDEX_BITS) - 1;
+    static constexpr auto MAX_GENERATION = (Handle {1} << (32u - INDEX_BITS)) - 1;
 
   private:
-    std::unordered_map<Handle, std::unique_ptr<Resource<T>>> _table {};
-    std::unordered_map<std::string, Handle> _cache {};
+    static constexpr auto NONE = std::numeric_limits<Handle>::max();
+
+    struct Slot {
+        T data {};
+        std::string name {};
+        Loader reload {};
+        size_t bytes = 0;
+        int32_t ref_count = 0;
+        Handle generation = 1;
+        bool alive = false;
+        // Links of unreferenced slots, from least to most recently released
+        bool in_lru = false;
+        Handle lru_prev = NONE;
+        Handle lru_next = NONE;
+    };
+
+    std::vector<Slot> _slots {};
+    std::vector<Handle> _free {};
+    std::unordered_map<std::string, Handle> _by_name {};
+    std::unordered_map<std::string, Loader> _evicted {};
+    Handle _lru_head = NONE;
+    Handle _lru_tail = NONE;
+    ResourceStats _stats {.budget_bytes = std::numeric_limits<size_t>::max()};
     T _default {};
 
   public:
-    auto load(std::string name, const std::function<auto()->T>& load_callback) noexcept -> Handle try {
+    /// Load resource or add reference to already loaded one with same name. `reload` loads it again after eviction,
+    /// by default `load_callback` is reused, so it must not refer to anything it does not own
+    auto load(std::string name, Loader load_callback, Loader reload = {}) noexcept -> Handle try {
         SPDLOG_TRACE("Loading Resource with name {}", name);
 
-        if (auto it = _cache.find(name); it != _cache.end()) {
+        if (auto it = _by_name.find(name); it != _by_name.end()) {
             SPDLOG_TRACE("Found resource {} in cache", name);
-            get(it->second);
+            _stats.hits++;
+            acquire(it->second & INDEX_MASK);
             return it->second;
         }
 
-        auto data = load_callback();
-        auto res = std::make_unique<Resource<T>>(std::move(data), 1);
-        auto handle = next_handle();
-        SPDLOG_DEBUG("Loaded resource [{}]", handle);
-        _table.insert({handle, std::move(res)});
-        _cache.insert({name, handle});
-        return handle;
+        _stats.misses++;
+        _evicted.erase(name);
+        if (!reload) reload = load_callback;
+        return insert(std::move(name), load_callback(), std::move(reload));
     } catch (std::exception& e) {
         SPDLOG_WARN("Unexpected C++ exception while loading resource: {}", e.what());
         return 0;
     }
 
-    auto load_by_name(const std::string& name) noexcept -> Handle {
-        auto handle_search = _cache.find(name);
-        if (handle_search == _cache.end()) return 0;
-        const auto handle = handle_search->second;
-        auto data_search = _table.find(handle);
-        if (data_search == _table.end()) {
-            SPDLOG_ERROR("Handle is prese");
-            return 0;
-        };
-        auto ptr = data_search->second.get();
-        ptr->ref_count++;
-        return handle;
+    /// Add reference to resource loaded before. Evicted resource is loaded again
+    auto load_by_name(const std::string& name) noexcept -> Handle try {
+        if (auto it = _by_name.find(name); it != _by_name.end()) {
+            _stats.hits++;
+            acquire(it->second & INDEX_MASK);
+            return it->second;
+        }
+
+        _stats.misses++;
+        auto it = _evicted.find(name);
+        if (it == _evicted.end()) return 0;
+        SPDLOG_DEBUG("Reloading evicted resource {}", name);
+        auto reload = std::move(it->second);
+        _evicted.erase(it);
+        auto data = reload();
+        return insert(name, std::move(data), std::move(reload));
+    } catch (std::exception& e) {
+        SPDLOG_WARN("Unexpected C++ exception while loading resource: {}", e.what());
+        return 0;
     }
 
     auto get(Handle handle) noexcept -> const T::data_type& {
-        if (auto it = _table.find(handle); it != _table.end()) {
-            auto ptr = it->second.get();
-            ptr->ref_count++;
-            return ptr->data.get();
-        } else {
-            return _default.get();
+        if (auto s = slot(handle)) {
+            acquire(handle & INDEX_MASK);
+            return s->data.get();
         }
+        return _default.get();
     }
 
     auto get_by_name(const std::string& name) noexcept -> const T::data_type& {
-        auto handle_search = _cache.find(name);
-        if (handle_search == _cache.end()) return _default.get();
-        const auto handle = handle_search->second;
-        auto data_search = _table.find(handle);
-        if (data_search == _table.end()) return _default.get();
-        return data_search->second.get();
+        auto it = _by_name.find(name);
+        if (it == _by_name.end()) return _default.get();
+        return slot(it->second)->data.get();
     }
 
     auto borrow(Handle handle) noexcept -> const T::data_type& {
-        if (auto it = _table.find(handle); it != _table.end()) {
-            return it->second->data.get();
-        } else {
-            return _default.get();
-        }
+        if (auto s = slot(handle)) return s->data.get();
+        return _default.get();
     }
 
-    auto release(Handle handle) noexcept -> void {
-        if (auto it = _table.find(handle); it != _table.end()) {
-            auto ptr = it->second.get();
-            ptr->ref_count--;
-            if (ptr->ref_count <= 0) {
-                if (ptr->ref_count < 0) SPDLOG_WARN("Reference count of resource is < 0");
-                SPDLOG_DEBUG("Unloading resource [{}]", handle);
-                _table.erase(handle);
-                std::erase_if(_cache, [=](const auto& item) -> bool { return item.second == handle; });
-            }
+    /// Drop reference. Unreferenced resource stays cached within budget, unless `keep_cached` is false
+    auto release(Handle handle, bool keep_cached = true) noexcept -> void {
+        auto s = slot(handle);
+        if (s == nullptr || s->ref_count <= 0) return;
+
+        s->ref_count--;
+        if (s->ref_count > 0) return;
+
+        if (!keep_cached) {
+            SPDLOG_DEBUG("Unloading resource [{}]", handle);
+            unload(handle & INDEX_MASK);
+            return;
         }
+
+        lru_push(handle & INDEX_MASK);
+        trim();
     }
 
+    /// Evict unreferenced resources until resident bytes fit in budget
+    auto set_budget(size_t bytes) noexcept -> void {
+        _stats.budget_bytes = bytes;
+        trim();
+    }
+
+    [[nodiscard]]
+    auto stats() const noexcept -> const ResourceStats& {
+        return _stats;
+    }
+
+    /// Unload everything. Slots keep their generations, so handles held past this never resolve again
     auto clear() noexcept -> void {
-        _table.clear();
-        _cache.clear();
+        for (auto index = Handle {}; index < _slots.size(); index++) {
+            if (_slots[index].alive) unload(index);
+        }
+        _evicted.clear();
     }
 
   private:
-    static auto next_handle() noexcept -> Handle {
-        static std::atomic_int32_t _handle_counter = 1;
-        return _handle_counter++;
+    static constexpr auto make_handle(Handle index, Handle generation) noexcept -> Handle {
+        return (generation << INDEX_BITS) | index;
+    }
+
+    auto slot(Handle handle) noexcept -> Slot * {
+        const auto index = handle & INDEX_MASK;
+        if (index >= _slots.size()) return nullptr;
+        auto& s = _slots[index];
+        if (!s.alive || s.generation != handle >> INDEX_BITS) return nullptr;
+        return &s;
+    }
+
+    auto insert(std::string name, T&& data, Loader&& reload) -> Handle {
+        const auto index = allocate();
+        if (!index) {
+            SPDLOG_WARN("Could not load resource {}: all {} slots are in use", name, INDEX_MASK);
+            return 0;
+        }
+
+        auto& s = _slots[*index];
+        s.data = std::move(data);
+        s.name = name;
+        s.reload = std::move(reload);
+        s.bytes = s.data.size_bytes();
+        s.ref_count = 1;
+        s.alive = true;
+        _stats.resident_bytes += s.bytes;
+        _stats.resident++;
+
+        const auto handle = make_handle(*index, s.generation);
+        SPDLOG_DEBUG("Loaded resource [{}] of {} bytes", handle, s.bytes);
+        _by_name.insert({std::move(name), handle});
+        trim();
+        return handle;
+    }
+
+    auto acquire(Handle index) noexcept -> void {
+        lru_remove(index);
+        _slots[index].ref_count++;
+    }
+
+    /// Evict least recently released resources while over budget. Referenced resources are never evicted
+    auto trim() noexcept -> void {
+        while (_stats.resident_bytes > _stats.budget_bytes && _lru_head != NONE) {
+            const auto index = _lru_head;
+            auto& s = _slots[index];
+            SPDLOG_DEBUG("Evicting resource {} of {} bytes", s.name, s.bytes);
+            try {
+                if (s.reload) _evicted.insert_or_assign(s.name, std::move(s.reload));
+            } catch (std::exception& e) {
+                SPDLOG_WARN("Evicted resource {} will not reload: {}", s.name, e.what());
+            }
+            _stats.evictions++;
+            unload(index);
+        }
+    }
+
+    auto unload(Handle index) noexcept -> void try {
+        auto& s = _slots[index];
+        lru_remove(index);
+        _by_name.erase(s.name);
+        _stats.resident_bytes -= s.bytes;
+        _stats.resident--;
+
+        s.data = T {};
+        s.name.clear();
+        s.reload = {};
+        s.bytes = 0;
+        s.ref_count = 0;
+        s.alive = false;
+        s.generation = s.generation == MAX_GENERATION ? 1 : s.generation + 1;
+        _free.push_back(index);
+    } catch (std::exception& e) {
+        // Slot is not reused when free list could not grow
+        SPDLOG_WARN("Unexpected C++ exception while unloading resource: {}", e.what());
+    }
+
+    auto lru_push(Handle index) noexcept -> void {
+        auto& s = _slots[index];
+        s.in_lru = true;
+        s.lru_prev = _lru_tail;
+        s.lru_next = NONE;
+        if (_lru_tail != NONE) _slots[_lru_tail].lru_next = index;
+        else _lru_head = index;
+        _lru_tail = index;
+        _stats.cached++;
+    }
+
+    auto lru_remove(Handle index) noexcept -> void {
+        auto& s = _slots[index];
+        if (!s.in_lru) return;
+        s.in_lru = false;
+        if (s.lru_prev != NONE) _slots[s.lru_prev].lru_next = s.lru_next;
+        else _lru_head = s.lru_next;
+        if (s.lru_next != NONE) _slots[s.lru_next].lru_prev = s.lru_prev;
+        else _lru_tail = s.lru_prev;
+        s.lru_prev = NONE;
+        s.lru_next = NONE;
+        _stats.cached--;
+    }
+
+    auto allocate() -> std::optional<Handle> {
+        if (!_free.empty()) {
+            const auto index = _free.back();
+            _free.pop_back();
+            return index;
+        }
+        if (_slots.size() >= INDEX_MASK) return std::nullopt;
+        _slots.emplace_back();
+        return Handle(_slots.size() - 1);
     }
 };
 
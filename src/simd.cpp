@@ -0,0 +1,345 @@
+#include <simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+    #include <arm_neon.h>
+#endif
+
+namespace glint::simd {
+
+/// One vector, used for vectors left after last full batch and on targets without vector instructions.
+/// Batches below have same interface and hold several xy pairs
+struct Scalar {
+    static constexpr auto NAME = "scalar";
+    static constexpr size_t WIDTH = 2;
+    float x, y;
+
+    static auto load(const float *p) noexcept -> Scalar {
+        return {p[0], p[1]};
+    }
+
+    static auto pairs(float px, float py) noexcept -> Scalar {
+        return {px, py};
+    }
+
+    static auto min(Scalar a, Scalar b) noexcept -> Scalar {
+        return {std::min(a.x, b.x), std::min(a.y, b.y)};
+    }
+
+    static auto max(Scalar a, Scalar b) noexcept -> Scalar {
+        return {std::max(a.x, b.x), std::max(a.y, b.y)};
+    }
+
+    static auto sqrt(Scalar a) noexcept -> Scalar {
+        return {std::sqrt(a.x), std::sqrt(a.y)};
+    }
+
+    /// Lanes of `value` where `mask` is positive, zero elsewhere
+    static auto where_positive(Scalar mask, Scalar value) noexcept -> Scalar {
+        return {mask.x > 0.0f ? value.x : 0.0f, mask.y > 0.0f ? value.y : 0.0f};
+    }
+
+    auto store(float *p) const noexcept -> void {
+        p[0] = x;
+        p[1] = y;
+    }
+
+    /// Swap x and y of every pair
+    [[nodiscard]]
+    auto swapped() const noexcept -> Scalar {
+        return {y, x};
+    }
+
+    friend auto operator+(Scalar a, Scalar b) noexcept -> Scalar {
+        return {a.x + b.x, a.y + b.y};
+    }
+
+    friend auto operator-(Scalar a, Scalar b) noexcept -> Scalar {
+        return {a.x - b.x, a.y - b.y};
+    }
+
+    friend auto operator*(Scalar a, Scalar b) noexcept -> Scalar {
+        return {a.x * b.x, a.y * b.y};
+    }
+
+    friend auto operator/(Scalar a, Scalar b) noexcept -> Scalar {
+        return {a.x / b.x, a.y / b.y};
+    }
+};
+
+#if defined(__AVX__)
+
+struct Avx {
+    static constexpr auto NAME = "AVX";
+    static constexpr size_t WIDTH = 8;
+    __m256 v;
+
+    static auto load(const float *p) noexcept -> Avx {
+        return {_mm256_loadu_ps(p)};
+    }
+
+    static auto pairs(float x, float y) noexcept -> Avx {
+        return {_mm256_setr_ps(x, y, x, y, x, y, x, y)};
+    }
+
+    static auto min(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_min_ps(a.v, b.v)};
+    }
+
+    static auto max(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_max_ps(a.v, b.v)};
+    }
+
+    static auto sqrt(Avx a) noexcept -> Avx {
+        return {_mm256_sqrt_ps(a.v)};
+    }
+
+    static auto where_positive(Avx mask, Avx value) noexcept -> Avx {
+        return {_mm256_and_ps(_mm256_cmp_ps(mask.v, _mm256_setzero_ps(), _CMP_GT_OQ), value.v)};
+    }
+
+    auto store(float *p) const noexcept -> void {
+        _mm256_storeu_ps(p, v);
+    }
+
+    [[nodiscard]]
+    auto swapped() const noexcept -> Avx {
+        return {_mm256_permute_ps(v, 0b10'11'00'01)};
+    }
+
+    friend auto operator+(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_add_ps(a.v, b.v)};
+    }
+
+    friend auto operator-(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_sub_ps(a.v, b.v)};
+    }
+
+    friend auto operator*(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_mul_ps(a.v, b.v)};
+    }
+
+    friend auto operator/(Avx a, Avx b) noexcept -> Avx {
+        return {_mm256_div_ps(a.v, b.v)};
+    }
+};
+
+using Native = Avx;
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+struct Sse {
+    static constexpr auto NAME = "SSE2";
+    static constexpr size_t WIDTH = 4;
+    __m128 v;
+
+    static auto load(const float *p) noexcept -> Sse {
+        return {_mm_loadu_ps(p)};
+    }
+
+    static auto pairs(float x, float y) noexcept -> Sse {
+        return {_mm_setr_ps(x, y, x, y)};
+    }
+
+    static auto min(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_min_ps(a.v, b.v)};
+    }
+
+    static auto max(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_max_ps(a.v, b.v)};
+    }
+
+    static auto sqrt(Sse a) noexcept -> Sse {
+        return {_mm_sqrt_ps(a.v)};
+    }
+
+    static auto where_positive(Sse mask, Sse value) noexcept -> Sse {
+        return {_mm_and_ps(_mm_cmpgt_ps(mask.v, _mm_setzero_ps()), value.v)};
+    }
+
+    auto store(float *p) const noexcept -> void {
+        _mm_storeu_ps(p, v);
+    }
+
+    [[nodiscard]]
+    auto swapped() const noexcept -> Sse {
+        return {_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))};
+    }
+
+    friend auto operator+(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_add_ps(a.v, b.v)};
+    }
+
+    friend auto operator-(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_sub_ps(a.v, b.v)};
+    }
+
+    friend auto operator*(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_mul_ps(a.v, b.v)};
+    }
+
+    friend auto operator/(Sse a, Sse b) noexcept -> Sse {
+        return {_mm_div_ps(a.v, b.v)};
+    }
+};
+
+using Native = Sse;
+
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+
+/// AArch64 only, 32-bit NEON has no vector division and square root
+struct Neon {
+    static constexpr auto NAME = "NEON";
+    static constexpr size_t WIDTH = 4;
+    float32x4_t v;
+
+    static auto load(const float *p) noexcept -> Neon {
+        return {vld1q_f32(p)};
+    }
+
+    static auto pairs(float x, float y) noexcept -> Neon {
+        const auto lanes = std::array {x, y, x, y};
+        return {vld1q_f32(lanes.data())};
+    }
+
+    static auto min(Neon a, Neon b) noexcept -> Neon {
+        return {vminq_f32(a.v, b.v)};
+    }
+
+    static auto max(Neon a, Neon b) noexcept -> Neon {
+        return {vmaxq_f32(a.v, b.v)};
+    }
+
+    static auto sqrt(Neon a) noexcept -> Neon {
+        return {vsqrtq_f32(a.v)};
+    }
+
+    static auto where_positive(Neon mask, Neon value) noexcept -> Neon {
+        const auto positive = vcgtq_f32(mask.v, vdupq_n_f32(0.0f));
+        return {vreinterpretq_f32_u32(vandq_u32(positive, vreinterpretq_u32_f32(value.v)))};
+    }
+
+    auto store(float *p) const noexcept -> void {
+        vst1q_f32(p, v);
+    }
+
+    [[nodiscard]]
+    auto swapped() const noexcept -> Neon {
+        return {vrev64q_f32(v)};
+    }
+
+    friend auto operator+(Neon a, Neon b) noexcept -> Neon {
+        return {vaddq_f32(a.v, b.v)};
+    }
+
+    friend auto operator-(Neon a, Neon b) noexcept -> Neon {
+        return {vsubq_f32(a.v, b.v)};
+    }
+
+    friend auto operator*(Neon a, Neon b) noexcept -> Neon {
+        return {vmulq_f32(a.v, b.v)};
+    }
+
+    friend auto operator/(Neon a, Neon b) noexcept -> Neon {
+        return {vdivq_f32(a.v, b.v)};
+    }
+};
+
+using Native = Neon;
+
+#else
+
+using Native = Scalar;
+
+#endif
+
+/// Call `kernel` with offset of every batch of native width, then of every vector left. `size` is in floats
+template<typename Kernel>
+static auto run(size_t size, Kernel&& kernel) noexcept -> void {
+    size -= size % 2;
+    auto i = size_t {};
+    for (; i + Native::WIDTH <= size; i += Native::WIDTH) kernel.template operator()<Native>(i);
+    for (; i < size; i += Scalar::WIDTH) kernel.template operator()<Scalar>(i);
+}
+
+auto instruction_set() noexcept -> const char * {
+    return Native::NAME;
+}
+
+auto add(std::span<float> vectors, std::span<const float> offsets) noexcept -> void {
+    run(std::min(vectors.size(), offsets.size()), [&]<typename B>(size_t i) {
+        (B::load(&vectors[i]) + B::load(&offsets[i])).store(&vectors[i]);
+    });
+}
+
+auto add(std::span<float> vectors, Vector2 offset) noexcept -> void {
+    run(vectors.size(), [&]<typename B>(size_t i) {
+        (B::load(&vectors[i]) + B::pairs(offset.x, offset.y)).store(&vectors[i]);
+    });
+}
+
+auto scale(std::span<float> vectors, Vector2 factor) noexcept -> void {
+    run(vectors.size(), [&]<typename B>(size_t i) {
+        (B::load(&vectors[i]) * B::pairs(factor.x, factor.y)).store(&vectors[i]);
+    });
+}
+
+auto mul_add(std::span<float> vectors, std::span<const float> deltas, float factor) noexcept -> void {
+    run(std::min(vectors.size(), deltas.size()), [&]<typename B>(size_t i) {
+        (B::load(&vectors[i]) + B::load(&deltas[i]) * B::pairs(factor, factor)).store(&vectors[i]);
+    });
+}
+
+auto rotate(std::span<float> vectors, float angle) noexcept -> void {
+    const auto c = std::cos(angle);
+    const auto s = std::sin(angle);
+    // x' = x * c - y * s, y' = y * c + x * s
+    run(vectors.size(), [&]<typename B>(size_t i) {
+        const auto v = B::load(&vectors[i]);
+        (v * B::pairs(c, c) + v.swapped() * B::pairs(-s, s)).store(&vectors[i]);
+    });
+}
+
+auto normalize(std::span<float> vectors) noexcept -> void {
+    run(vectors.size(), [&]<typename B>(size_t i) {
+        const auto v = B::load(&vectors[i]);
+        const auto squares = v * v;
+        // Squared length in both lanes of pair
+        const auto length_sqr = squares + squares.swapped();
+        B::where_positive(length_sqr, v / B::sqrt(length_sqr)).store(&vectors[i]);
+    });
+}
+
+auto clamp(std::span<float> vectors, Vector2 min, Vector2 max) noexcept -> void {
+    run(vectors.size(), [&]<typename B>(size_t i) {
+        const auto v = B::load(&vectors[i]);
+        B::min(B::max(v, B::pairs(min.x, min.y)), B::pairs(max.x, max.y)).store(&vectors[i]);
+    });
+}
+
+auto distance(std::span<const float> vectors, Vector2 point, std::span<float> distances) noexcept -> void {
+    run(std::min(vectors.size(), distances.size() * 2), [&]<typename B>(size_t i) {
+        const auto d = B::load(&vectors[i]) - B::pairs(point.x, point.y);
+        const auto squares = d * d;
+        auto lanes = std::array<float, B::WIDTH> {};
+        B::sqrt(squares + squares.swapped()).store(lanes.data());
+        for (size_t k = 0; k < B::WIDTH / 2; k++) distances[i / 2 + k] = lanes[k * 2];
+    });
+}
+
+auto lerp(std::span<float> vectors, std::span<const float> targets, float amount) noexcept -> void {
+    run(std::min(vectors.size(), targets.size()), [&]<typename B>(size_t i) {
+        const auto v = B::load(&vectors[i]);
+        (v + (B::load(&targets[i]) - v) * B::pairs(amount, amount)).store(&vectors[i]);
+    });
+}
+
+} // namespace glint::simd
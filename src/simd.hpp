@@ -0,0 +1,42 @@
+#pragma once
+
+#include <span>
+
+#include <raylib.h>
+
+/// Kernels over packed xy pairs, like Float32Array of vectors. Spans of pairs must have even length, and spans passed
+/// together must hold same number of vectors. Built with AVX, SSE2 or NEON when target has them, scalar otherwise
+namespace glint::simd {
+
+/// Instruction set kernels were built with
+[[nodiscard]]
+auto instruction_set() noexcept -> const char *;
+
+/// `vectors += offsets`
+auto add(std::span<float> vectors, std::span<const float> offsets) noexcept -> void;
+
+/// Add same offset to every vector
+auto add(std::span<float> vectors, Vector2 offset) noexcept -> void;
+
+/// Multiply components of every vector by components of `factor`
+auto scale(std::span<float> vectors, Vector2 factor) noexcept -> void;
+
+/// `vectors += deltas * factor`, like `position += velocity * dt`
+auto mul_add(std::span<float> vectors, std::span<const float> deltas, float factor) noexcept -> void;
+
+/// Rotate every vector around origin by `angle` radians
+auto rotate(std::span<float> vectors, float angle) noexcept -> void;
+
+/// Scale every vector to unit length, zero vectors stay zero
+auto normalize(std::span<float> vectors) noexcept -> void;
+
+/// Clamp components of every vector between components of `min` and `max`
+auto clamp(std::span<float> vectors, Vector2 min, Vector2 max) noexcept -> void;
+
+/// Distance from every vector to `point`, `distances` holds one element per vector
+auto distance(std::span<const float> vectors, Vector2 point, std::span<float> distances) noexcept -> void;
+
+/// `vectors += (targets - vectors) * amount`
+auto lerp(std::span<float> vectors, std::span<const float> targets, float amount) noexcept -> void;
+
+} // namespace glint::simd
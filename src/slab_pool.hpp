@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl>
+
+namespace glint {
+
+using namespace gsl;
+
+/// Fixed-size object pool. Memory is taken from the system in slabs of `SLAB_SIZE` objects and freed objects are
+/// kept in intrusive free list, so creating and destroying objects does not touch global allocator after warm up.
+/// Slabs are only returned when pool is destroyed, so all objects must be destroyed before that.
+template<typename T, size_t SLAB_SIZE = 256>
+class SlabPool {
+  private:
+    union Slot {
+        Slot *next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> _slabs {};
+    Slot *_free = nullptr;
+    size_t _live = 0;
+
+  public:
+    SlabPool() noexcept = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool(SlabPool&&) noexcept = default;
+    auto operator=(const SlabPool&) -> SlabPool& = delete;
+    auto operator=(SlabPool&&) noexcept -> SlabPool& = default;
+    ~SlabPool() noexcept = default;
+
+    /// Construct object in pool. Throws `std::bad_alloc` only when new slab could not be allocated
+    template<typename... Args>
+    [[nodiscard]]
+    auto create(Args&&...args) -> owner<T *> {
+        if (_free == nullptr) grow();
+        auto slot = _free;
+        _free = slot->next;
+        auto ptr = new (slot->storage) T {std::forward<Args>(args)...};
+        _live++;
+        return ptr;
+    }
+
+    /// Destroy object previously created by this pool. Null is ignored
+    auto destroy(owner<T *> ptr) noexcept -> void {
+        if (ptr == nullptr) return;
+        ptr->~T();
+        // NOLINTNEXTLINE: object storage is the first member of slot
+        auto slot = reinterpret_cast<Slot *>(ptr);
+        slot->next = _free;
+        _free = slot;
+        _live--;
+    }
+
+    /// Number of objects currently alive
+    [[nodiscard]]
+    auto size() const noexcept -> size_t {
+        return _live;
+    }
+
+    /// Number of objects pool can hold without allocating
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_t {
+        return _slabs.size() * SLAB_SIZE;
+    }
+
+  private:
+    auto grow() -> void {
+        auto slab = std::make_unique<Slot[]>(SLAB_SIZE);
+        for (size_t i = 0; i < SLAB_SIZE; i++) {
+            slab[i].next = i + 1 < SLAB_SIZE ? &slab[i + 1] : _free;
+        }
+        _free = &slab[0];
+        _slabs.push_back(std::move(slab));
+    }
+};
+
+} // namespace glint
@@ -0,0 +1,409 @@
+#include <texture_container.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include <fmt/format.h>
+
+namespace glint {
+
+static constexpr auto DDS_MAGIC = std::array<unsigned char, 4> {'D', 'D', 'S', ' '};
+static constexpr auto KTX_MAGIC =
+    std::array<unsigned char, 12> {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+/// Magic and DDS_HEADER
+static constexpr auto DDS_HEADER_SIZE = size_t {128};
+static constexpr auto DDS_DX10_HEADER_SIZE = size_t {20};
+static constexpr auto DDS_HEADER_STRUCT_SIZE = uint32_t {124};
+static constexpr auto DDS_PIXEL_FORMAT_SIZE = uint32_t {32};
+static constexpr auto DDSD_CAPS = uint32_t {0x1};
+static constexpr auto DDSD_HEIGHT = uint32_t {0x2};
+static constexpr auto DDSD_WIDTH = uint32_t {0x4};
+static constexpr auto DDSD_PIXELFORMAT = uint32_t {0x1000};
+static constexpr auto DDSD_MIPMAPCOUNT = uint32_t {0x20000};
+static constexpr auto DDSD_LINEARSIZE = uint32_t {0x80000};
+static constexpr auto DDPF_ALPHAPIXELS = uint32_t {0x1};
+static constexpr auto DDPF_FOURCC = uint32_t {0x4};
+static constexpr auto DDPF_RGB = uint32_t {0x40};
+static constexpr auto DDSCAPS_TEXTURE = uint32_t {0x1000};
+
+static constexpr auto KTX_HEADER_SIZE = size_t {64};
+static constexpr auto KTX_NATIVE_ENDIAN = uint32_t {0x04030201};
+
+static constexpr auto MAX_SIDE = uint32_t {16384};
+
+static constexpr auto fourcc(const char (&code)[5]) noexcept -> uint32_t {
+    return uint32_t(uint8_t(code[0])) | uint32_t(uint8_t(code[1])) << 8 | uint32_t(uint8_t(code[2])) << 16
+           | uint32_t(uint8_t(code[3])) << 24;
+}
+
+static auto read_u32(std::span<const unsigned char> bytes, size_t offset) noexcept -> uint32_t {
+    return uint32_t(bytes[offset]) | uint32_t(bytes[offset + 1]) << 8 | uint32_t(bytes[offset + 2]) << 16
+           | uint32_t(bytes[offset + 3]) << 24;
+}
+
+static auto put_u16(std::vector<unsigned char>& out, uint32_t value) -> void {
+    out.push_back(static_cast<unsigned char>(value & 0xff));
+    out.push_back(static_cast<unsigned char>((value >> 8) & 0xff));
+}
+
+static auto put_u32(std::vector<unsigned char>& out, uint32_t value) -> void {
+    put_u16(out, value & 0xffff);
+    put_u16(out, value >> 16);
+}
+
+template<size_t N>
+static auto starts_with(std::span<const unsigned char> bytes, const std::array<unsigned char, N>& magic) noexcept
+    -> bool {
+    return bytes.size() >= N && std::equal(magic.begin(), magic.end(), bytes.begin());
+}
+
+auto is_texture_container(std::span<const unsigned char> bytes) noexcept -> bool {
+    return starts_with(bytes, DDS_MAGIC) || starts_with(bytes, KTX_MAGIC);
+}
+
+/// Size of one mip level as stored in container, whole blocks even for levels smaller than a block
+static auto stored_level_size(int width, int height, int format) noexcept -> size_t {
+    const auto blocks = [&](int side) {
+        return size_t(std::max((width + side - 1) / side, 1)) * size_t(std::max((height + side - 1) / side, 1));
+    };
+    switch (format) {
+        case PIXELFORMAT_COMPRESSED_DXT1_RGB:
+        case PIXELFORMAT_COMPRESSED_DXT1_RGBA:
+        case PIXELFORMAT_COMPRESSED_ETC1_RGB:
+        case PIXELFORMAT_COMPRESSED_ETC2_RGB:
+            return blocks(4) * 8;
+        case PIXELFORMAT_COMPRESSED_DXT3_RGBA:
+        case PIXELFORMAT_COMPRESSED_DXT5_RGBA:
+        case PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA:
+        case PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA:
+            return blocks(4) * 16;
+        case PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA:
+            return blocks(8) * 16;
+        default:
+            return size_t(std::max(::GetPixelDataSize(width, height, format), 0));
+    }
+}
+
+/// Copy levels into image owned by raylib allocator. raylib walks mip chain using its own level sizes, chain is cut at
+/// first level where they differ from stored ones, which only happens for levels smaller than a block
+static auto make_image(std::span<const std::span<const unsigned char>> levels, int width, int height, int format)
+    -> Result<rl::Image> {
+    auto size = size_t {};
+    auto mipmaps = 0;
+    for (const auto level : levels) {
+        const auto w = std::max(width >> mipmaps, 1);
+        const auto h = std::max(height >> mipmaps, 1);
+        if (level.size() != size_t(std::max(::GetPixelDataSize(w, h, format), 0))) break;
+        size += level.size();
+        mipmaps++;
+    }
+    if (mipmaps == 0) return err("Texture container has no usable image data");
+
+    const auto data = static_cast<unsigned char *>(::MemAlloc(unsigned(size)));
+    if (data == nullptr) return err("Out of memory");
+    auto offset = size_t {};
+    for (const auto level : levels.first(size_t(mipmaps))) {
+        std::memcpy(data + offset, level.data(), level.size());
+        offset += level.size();
+    }
+    return rl::Image::adopt(
+        ::Image {.data = data, .width = width, .height = height, .mipmaps = mipmaps, .format = format}
+    );
+}
+
+static auto dds_format(std::span<const unsigned char> bytes, size_t& data_offset) -> Result<int> {
+    const auto flags = read_u32(bytes, 80);
+    const auto code = read_u32(bytes, 84);
+
+    if ((flags & DDPF_FOURCC) != 0) {
+        switch (code) {
+            case fourcc("DXT1"):
+                if ((flags & DDPF_ALPHAPIXELS) != 0) return PIXELFORMAT_COMPRESSED_DXT1_RGBA;
+                return PIXELFORMAT_COMPRESSED_DXT1_RGB;
+            case fourcc("DXT3"):
+                return PIXELFORMAT_COMPRESSED_DXT3_RGBA;
+            case fourcc("DXT5"):
+                return PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+            case fourcc("DX10"): {
+                if (bytes.size() < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE) return err("DDS file is truncated");
+                data_offset += DDS_DX10_HEADER_SIZE;
+                const auto dxgi = read_u32(bytes, DDS_HEADER_SIZE);
+                // BC1, BC2 and BC3 in UNORM and UNORM_SRGB variants
+                if (dxgi == 71 || dxgi == 72) return PIXELFORMAT_COMPRESSED_DXT1_RGBA;
+                if (dxgi == 74 || dxgi == 75) return PIXELFORMAT_COMPRESSED_DXT3_RGBA;
+                if (dxgi == 77 || dxgi == 78) return PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+                if (dxgi == 28 || dxgi == 29) return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+                return err(fmt::format("Unsupported DDS DXGI format {}", dxgi));
+            }
+            default:
+                return err(fmt::format("Unsupported DDS format {:#010x}", code));
+        }
+    }
+
+    const auto is_rgba8 = (flags & DDPF_RGB) != 0 && (flags & DDPF_ALPHAPIXELS) != 0 && read_u32(bytes, 88) == 32
+                          && read_u32(bytes, 92) == 0xff && read_u32(bytes, 96) == 0xff00
+                          && read_u32(bytes, 100) == 0xff0000 && read_u32(bytes, 104) == 0xff000000;
+    if (is_rgba8) return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return err("Unsupported uncompressed DDS pixel layout");
+}
+
+static auto load_dds(std::span<const unsigned char> bytes) -> Result<rl::Image> {
+    if (bytes.size() < DDS_HEADER_SIZE || read_u32(bytes, 4) != DDS_HEADER_STRUCT_SIZE) {
+        return err("DDS file is truncated");
+    }
+
+    const auto flags = read_u32(bytes, 8);
+    const auto height = read_u32(bytes, 12);
+    const auto width = read_u32(bytes, 16);
+    const auto mipmaps = (flags & DDSD_MIPMAPCOUNT) != 0 ? std::max(read_u32(bytes, 28), 1u) : 1u;
+    if (width == 0 || height == 0 || width > MAX_SIDE || height > MAX_SIDE) {
+        return err(fmt::format("Invalid DDS size {}x{}", width, height));
+    }
+
+    auto offset = DDS_HEADER_SIZE;
+    const auto format = dds_format(bytes, offset);
+    if (!format) return err(format);
+
+    auto levels = std::vector<std::span<const unsigned char>> {};
+    for (auto level = 0u; level < mipmaps && level < 32; level++) {
+        const auto w = std::max(int(width >> level), 1);
+        const auto h = std::max(int(height >> level), 1);
+        const auto size = stored_level_size(w, h, *format);
+        if (offset + size > bytes.size()) break;
+        levels.push_back(bytes.subspan(offset, size));
+        offset += size;
+    }
+    return make_image(levels, int(width), int(height), *format);
+}
+
+static auto ktx_format(uint32_t internal_format) -> std::optional<int> {
+    switch (internal_format) {
+        case 0x83F0:
+            return PIXELFORMAT_COMPRESSED_DXT1_RGB;
+        case 0x83F1:
+            return PIXELFORMAT_COMPRESSED_DXT1_RGBA;
+        case 0x83F2:
+            return PIXELFORMAT_COMPRESSED_DXT3_RGBA;
+        case 0x83F3:
+            return PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+        case 0x8D64:
+            return PIXELFORMAT_COMPRESSED_ETC1_RGB;
+        case 0x9274:
+            return PIXELFORMAT_COMPRESSED_ETC2_RGB;
+        case 0x9278:
+            return PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA;
+        case 0x93B0:
+            return PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA;
+        case 0x93B7:
+            return PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA;
+        // GL_RGBA8 and GL_RGBA
+        case 0x8058:
+        case 0x1908:
+            return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        default:
+            return std::nullopt;
+    }
+}
+
+static auto load_ktx(std::span<const unsigned char> bytes) -> Result<rl::Image> {
+    if (bytes.size() < KTX_HEADER_SIZE) return err("KTX file is truncated");
+    if (read_u32(bytes, 12) != KTX_NATIVE_ENDIAN) return err("Big-endian KTX files are not supported");
+
+    const auto internal_format = read_u32(bytes, 28);
+    const auto format = ktx_format(internal_format);
+    if (!format) return err(fmt::format("Unsupported KTX internal format {:#06x}", internal_format));
+    // GL_UNSIGNED_BYTE, compressed formats have type 0
+    if (*format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 && read_u32(bytes, 16) != 0x1401) {
+        return err("Unsupported KTX pixel type");
+    }
+
+    const auto width = read_u32(bytes, 36);
+    const auto height = read_u32(bytes, 40);
+    if (width == 0 || height == 0 || width > MAX_SIDE || height > MAX_SIDE) {
+        return err(fmt::format("Invalid KTX size {}x{}", width, height));
+    }
+    if (read_u32(bytes, 44) > 1 || read_u32(bytes, 48) > 1 || read_u32(bytes, 52) != 1) {
+        return err("Only 2D KTX textures without arrays and cube faces are supported");
+    }
+    const auto mipmaps = std::max(read_u32(bytes, 56), 1u);
+
+    auto offset = KTX_HEADER_SIZE + size_t {read_u32(bytes, 60)};
+    auto levels = std::vector<std::span<const unsigned char>> {};
+    for (auto level = 0u; level < mipmaps && level < 32; level++) {
+        if (offset + 4 > bytes.size()) break;
+        const auto size = size_t {read_u32(bytes, offset)};
+        offset += 4;
+        if (offset + size > bytes.size()) break;
+        levels.push_back(bytes.subspan(offset, size));
+        // Levels are padded to 4 bytes
+        offset += (size + 3) & ~size_t {3};
+    }
+    return make_image(levels, int(width), int(height), *format);
+}
+
+auto load_texture_container(std::span<const unsigned char> bytes) noexcept -> Result<rl::Image> try {
+    if (starts_with(bytes, DDS_MAGIC)) return load_dds(bytes);
+    if (starts_with(bytes, KTX_MAGIC)) return load_ktx(bytes);
+    return err("Not a DDS or KTX texture");
+} catch (std::exception& e) {
+    return err(e);
+}
+
+using Block = std::array<std::array<unsigned char, 4>, 16>;
+
+static auto to_565(int r, int g, int b) noexcept -> uint32_t {
+    const auto r5 = uint32_t((r * 31 + 127) / 255);
+    const auto g6 = uint32_t((g * 63 + 127) / 255);
+    const auto b5 = uint32_t((b * 31 + 127) / 255);
+    return r5 << 11 | g6 << 5 | b5;
+}
+
+static auto from_565(uint32_t c) noexcept -> std::array<int, 3> {
+    const auto r = int(c >> 11) & 31;
+    const auto g = int(c >> 5) & 63;
+    const auto b = int(c) & 31;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// Color half of block: endpoints at color bounding box inset by 1/16 of its size, every pixel takes nearest of
+/// four interpolated colors
+static auto encode_color_block(const Block& block, std::vector<unsigned char>& out) -> void {
+    auto lo = std::array<int, 3> {255, 255, 255};
+    auto hi = std::array<int, 3> {0, 0, 0};
+    for (const auto& px : block) {
+        for (size_t c = 0; c < 3; c++) {
+            lo[c] = std::min(lo[c], int(px[c]));
+            hi[c] = std::max(hi[c], int(px[c]));
+        }
+    }
+    for (size_t c = 0; c < 3; c++) {
+        const auto inset = (hi[c] - lo[c]) / 16;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+
+    auto c0 = to_565(hi[0], hi[1], hi[2]);
+    auto c1 = to_565(lo[0], lo[1], lo[2]);
+    // First endpoint must be greater for four color mode of DXT1
+    if (c0 < c1) std::swap(c0, c1);
+
+    auto indices = uint32_t {};
+    if (c0 != c1) {
+        const auto p0 = from_565(c0);
+        const auto p1 = from_565(c1);
+        auto palette = std::array<std::array<int, 3>, 4> {p0, p1};
+        for (size_t c = 0; c < 3; c++) {
+            palette[2][c] = (2 * p0[c] + p1[c]) / 3;
+            palette[3][c] = (p0[c] + 2 * p1[c]) / 3;
+        }
+        for (size_t i = 0; i < block.size(); i++) {
+            auto best = uint32_t {};
+            auto best_distance = std::numeric_limits<int>::max();
+            for (size_t p = 0; p < palette.size(); p++) {
+                auto distance = 0;
+                for (size_t c = 0; c < 3; c++) {
+                    const auto d = int(block[i][c]) - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < best_distance) {
+                    best = uint32_t(p);
+                    best_distance = distance;
+                }
+            }
+            indices |= best << (2 * i);
+        }
+    }
+
+    put_u16(out, c0);
+    put_u16(out, c1);
+    put_u32(out, indices);
+}
+
+/// Alpha half of DXT5 block, using eight interpolated values between min and max alpha
+static auto encode_alpha_block(const Block& block, std::vector<unsigned char>& out) -> void {
+    auto a0 = 0;
+    auto a1 = 255;
+    for (const auto& px : block) {
+        a0 = std::max(a0, int(px[3]));
+        a1 = std::min(a1, int(px[3]));
+    }
+
+    auto indices = uint64_t {};
+    if (a0 != a1) {
+        auto palette = std::array<int, 8> {a0, a1};
+        for (auto i = 1; i < 7; i++) palette[size_t(i + 1)] = ((7 - i) * a0 + i * a1) / 7;
+        for (size_t i = 0; i < block.size(); i++) {
+            auto best = uint64_t {};
+            auto best_distance = 256;
+            for (size_t p = 0; p < palette.size(); p++) {
+                const auto distance = std::abs(int(block[i][3]) - palette[p]);
+                if (distance < best_distance) {
+                    best = p;
+                    best_distance = distance;
+                }
+            }
+            indices |= best << (3 * i);
+        }
+    }
+
+    out.push_back(static_cast<unsigned char>(a0));
+    out.push_back(static_cast<unsigned char>(a1));
+    for (auto i = 0; i < 6; i++) out.push_back(static_cast<unsigned char>((indices >> (8 * i)) & 0xff));
+}
+
+auto encode_dds(const rl::Image& image) noexcept -> Result<std::vector<unsigned char>> try {
+    if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return err("Only RGBA8 images can be compressed");
+    if (image.width <= 0 || image.height <= 0 || image.width % 4 != 0 || image.height % 4 != 0) {
+        return err(fmt::format("Image size {}x{} is not multiple of 4", image.width, image.height));
+    }
+
+    const auto width = size_t(image.width);
+    const auto height = size_t(image.height);
+    const auto pixels = std::span(static_cast<const unsigned char *>(image.data), width * height * 4);
+    auto opaque = true;
+    for (size_t i = 3; i < pixels.size(); i += 4) opaque = opaque && pixels[i] == 255;
+
+    const auto block_size = opaque ? size_t {8} : size_t {16};
+    const auto data_size = (width / 4) * (height / 4) * block_size;
+
+    auto out = std::vector<unsigned char> {};
+    out.reserve(DDS_HEADER_SIZE + data_size);
+    out.insert(out.end(), DDS_MAGIC.begin(), DDS_MAGIC.end());
+    put_u32(out, DDS_HEADER_STRUCT_SIZE);
+    put_u32(out, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE);
+    put_u32(out, uint32_t(height));
+    put_u32(out, uint32_t(width));
+    put_u32(out, uint32_t(data_size));
+    // Depth, mipmap count and reserved words
+    for (auto i = 0; i < 13; i++) put_u32(out, 0);
+    put_u32(out, DDS_PIXEL_FORMAT_SIZE);
+    put_u32(out, DDPF_FOURCC);
+    put_u32(out, opaque ? fourcc("DXT1") : fourcc("DXT5"));
+    // Bit count and masks are unused for compressed formats
+    for (auto i = 0; i < 5; i++) put_u32(out, 0);
+    put_u32(out, DDSCAPS_TEXTURE);
+    // Other caps and reserved word
+    for (auto i = 0; i < 4; i++) put_u32(out, 0);
+
+    auto block = Block {};
+    for (size_t by = 0; by < height; by += 4) {
+        for (size_t bx = 0; bx < width; bx += 4) {
+            for (size_t i = 0; i < block.size(); i++) {
+                const auto offset = ((by + i / 4) * width + bx + i % 4) * 4;
+                std::copy_n(pixels.begin() + ptrdiff_t(offset), 4, block[i].begin());
+            }
+            if (!opaque) encode_alpha_block(block, out);
+            encode_color_block(block, out);
+        }
+    }
+    return out;
+} catch (std::exception& e) {
+    return err(e);
+}
+
+} // namespace glint
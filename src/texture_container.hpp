@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <error.hpp>
+#include <raylib.hpp>
+
+namespace glint {
+
+/// Name of compressed copy that packer stores next to image, like `sprites/bg.png.dds`. Texture loader prefers it,
+/// while original image stays for everything that needs its pixels, such as runtime atlases and bitmap fonts
+[[nodiscard]]
+inline auto compressed_texture_path(const std::filesystem::path& image) -> std::filesystem::path {
+    return std::filesystem::path {image}.concat(".dds");
+}
+
+/// Whether bytes are DDS or KTX 1 container, recognized by signature rather than file extension
+[[nodiscard]]
+auto is_texture_container(std::span<const unsigned char> bytes) noexcept -> bool;
+
+/// Read DDS or KTX 1 container into image keeping its GPU format, so that compressed blocks are uploaded as they are.
+/// Supports DXT1/3/5 (BC1-3), ETC1, ETC2, ASTC 4x4 and 8x8 with all mipmap levels, and uncompressed RGBA8
+[[nodiscard]]
+auto load_texture_container(std::span<const unsigned char> bytes) noexcept -> Result<rl::Image>;
+
+/// Compress RGBA8 image into DDS container: DXT1 when image is opaque, DXT5 otherwise.
+/// Image sides must be multiple of 4. Encoder fits block endpoints to color bounding box, which is fast and good
+/// enough for backgrounds and other large textures, but can band on smooth gradients
+[[nodiscard]]
+auto encode_dds(const rl::Image& image) noexcept -> Result<std::vector<unsigned char>>;
+
+} // namespace glint
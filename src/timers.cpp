@@ -0,0 +1,99 @@
+#include <timers.hpp>
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace glint {
+
+auto TimerQueue::set_timeout(js::Function&& callback, double due) -> Id {
+    const auto id = _next_id++;
+    _callbacks.insert({id, std::move(callback)});
+    _heap.push(Entry {.due = due, .id = id});
+    return id;
+}
+
+auto TimerQueue::request_frame(js::Function&& callback) -> Id {
+    const auto id = _next_id++;
+    _callbacks.insert({id, std::move(callback)});
+    _frame_callbacks.push_back(id);
+    return id;
+}
+
+auto TimerQueue::cancel(Id id) noexcept -> void try {
+    if (_callbacks.erase(id) == 0) return;
+    // Frame callbacks are not in heap
+    if (std::ranges::find(_frame_callbacks, id) != _frame_callbacks.end()) return;
+    // Games that keep cancelling long timeouts, like debounced ones, would otherwise grow heap without bound
+    if (++_stale > _heap.size() / 2) compact();
+} catch (std::exception& e) {
+    SPDLOG_ERROR("Unexpected C++ exception while cancelling timer: {}", e.what());
+}
+
+auto TimerQueue::run(not_null<JSContext *> js, double now, double dt) noexcept -> void try {
+    // Callbacks scheduled while running get ids from here on and wait for next frame, so that zero timeout or
+    // frame callback requesting itself can not loop forever
+    const auto first_new = _next_id;
+
+    const auto fire = [&](Id id, auto&&...args) {
+        auto it = _callbacks.find(id);
+        if (it == _callbacks.end()) return;
+        auto callback = std::move(it->second);
+        _callbacks.erase(it);
+        if (auto r = callback.call(JS_UNDEFINED, args...); !r) {
+            SPDLOG_ERROR("Uncaught exception in timer callback: {}", r.error().msg());
+        }
+    };
+
+    auto frame_callbacks = std::vector<Id> {};
+    std::swap(frame_callbacks, _frame_callbacks);
+    for (const auto id : frame_callbacks) {
+        fire(id, js::own(js, JS_NewFloat64(js, dt)));
+    }
+
+    auto deferred = std::vector<Entry> {};
+    while (!_heap.empty() && _heap.top().due <= now) {
+        const auto entry = _heap.top();
+        _heap.pop();
+        if (!_callbacks.contains(entry.id)) {
+            // Cancelled, may be uncounted if it was deferred while heap was compacted
+            if (_stale > 0) _stale--;
+        } else if (entry.id >= first_new) {
+            deferred.push_back(entry);
+        } else {
+            fire(entry.id);
+        }
+    }
+    for (const auto& entry : deferred) _heap.push(entry);
+
+    // Heap only shrinks as entries come due, drop it when every remaining timer was cancelled
+    if (_callbacks.empty()) {
+        _heap = {};
+        _stale = 0;
+    }
+} catch (std::exception& e) {
+    SPDLOG_ERROR("Unexpected C++ exception while running timers: {}", e.what());
+}
+
+auto TimerQueue::clear() noexcept -> void {
+    _heap = {};
+    _stale = 0;
+    _frame_callbacks.clear();
+    _callbacks.clear();
+}
+
+auto TimerQueue::pending() const noexcept -> size_t {
+    return _callbacks.size();
+}
+
+auto TimerQueue::compact() -> void {
+    auto live = std::vector<Entry> {};
+    live.reserve(_heap.size() - std::min(_stale, _heap.size()));
+    for (; !_heap.empty(); _heap.pop()) {
+        if (_callbacks.contains(_heap.top().id)) live.push_back(_heap.top());
+    }
+    _heap = decltype(_heap) {std::greater<> {}, std::move(live)};
+    _stale = 0;
+}
+
+} // namespace glint
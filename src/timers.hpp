@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include <quickjs.hpp>
+
+namespace glint {
+
+using namespace gsl;
+
+/// Timers and frame callbacks scheduled by game. They fire at frame boundary once engine time reaches their deadline,
+/// so they follow engine clock, which advances by fixed `dt` in headless mode.
+/// Deadlines are kept in a min-heap, so a frame with no due timers costs one comparison regardless of timer count.
+class TimerQueue {
+  public:
+    using Id = uint32_t;
+
+  private:
+    struct Entry {
+        double due;
+        Id id;
+
+        /// Equal deadlines fire in scheduling order
+        auto operator>(const Entry& other) const noexcept -> bool {
+            return due != other.due ? due > other.due : id > other.id;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> _heap {};
+    // Cancelled entries are only removed from here, heap skips them when they come up
+    std::unordered_map<Id, js::Function> _callbacks {};
+    std::vector<Id> _frame_callbacks {};
+    /// Cancelled timers still in heap, it is rebuilt once they are half of it
+    size_t _stale = 0;
+    Id _next_id = 1;
+
+  public:
+    /// Call `callback` on first frame boundary at or after `due`, but never on the one it was scheduled from
+    [[nodiscard]]
+    auto set_timeout(js::Function&& callback, double due) -> Id;
+
+    /// Call `callback` with frame dt at start of next frame
+    [[nodiscard]]
+    auto request_frame(js::Function&& callback) -> Id;
+
+    /// Cancel timer or frame callback. Unknown and already fired ids are ignored
+    auto cancel(Id id) noexcept -> void;
+
+    /// Fire frame callbacks requested before this call, then timers due at `now`
+    auto run(not_null<JSContext *> js, double now, double dt) noexcept -> void;
+
+    /// Drop all callbacks. Must be called before JS runtime is freed
+    auto clear() noexcept -> void;
+
+    [[nodiscard]]
+    auto pending() const noexcept -> size_t;
+
+  private:
+    /// Rebuild heap without cancelled timers
+    auto compact() -> void;
+};
+
+} // namespace glint
@@ -0,0 +1,74 @@
+import Rectangle from "glint:Rectangle";
+import Texture from "glint:Texture";
+
+export interface AtlasOptions {
+    /** Maximum width and height of one page, 2048 by default */
+    pageSize?: number;
+    /** Transparent pixels between images, 2 by default */
+    padding?: number;
+}
+
+/**
+ * Many images packed into few large textures, so that drawing them does not switch textures
+ *
+ * @example
+ * ```js
+ * import Atlas from "glint:Atlas";
+ * import Color from "glint:Color";
+ * import graphics from "glint:graphics";
+ *
+ * const atlas = new Atlas(["player.png", "enemy.png", "coin.png"]);
+ * const player = atlas.region("player.png");
+ *
+ * // Regions can be drawn by every graphics.texture* function
+ * graphics.texture(player, 100, 100, Color.WHITE);
+ * ```
+ */
+export class Atlas {
+    /**
+     * Load images and pack them into pages
+     * @param paths Image files, each one becomes a region named by its path
+     */
+    constructor(paths: string[], options?: AtlasOptions);
+
+    /**
+     * Load atlas baked from sprite folder by `glint pack` or `glint bake`, decoding only its pages
+     * @param folder Path of `*.atlas` folder. Regions are named by image paths relative to it
+     */
+    constructor(folder: string);
+
+    /**
+     * Decode and pack images on worker thread and upload pages at start of next frame
+     * @returns Promise resolved with packed atlas
+     */
+    static load(paths: string[], options?: AtlasOptions): Promise<Atlas>;
+
+    static load(folder: string): Promise<Atlas>;
+
+    get pageCount(): number;
+
+    /** Names of all regions */
+    get names(): string[];
+
+    /** Region of image loaded from `name`, or undefined if atlas has no such image */
+    region(name: string): AtlasRegion | undefined;
+
+    /** Page texture, for example to use with SpriteBatch and region sources */
+    page(index: number): Texture;
+
+    /** Release pages. Regions and page textures taken from atlas stay valid */
+    unload(): void;
+}
+
+/**
+ * Part of atlas page holding one image. Source rectangles passed to `graphics.textureRec`, `graphics.texturePro` and
+ * `graphics.textureNPatch` together with region are relative to it
+ */
+export interface AtlasRegion {
+    /** Rectangle of image in page texture */
+    readonly source: Rectangle;
+
+    readonly page: Texture;
+}
+
+export default Atlas;
@@ -3,7 +3,33 @@ export class Font {
 
     constructor(options: { name: string });
 
-    constructor(options: { path: string; name?: string; fontSize?: number; codepoints?: number[] });
+    /**
+     * @param options.dynamic Rasterize glyphs the first time they are drawn, instead of baking `codepoints` at load.
+     * Rarely drawn glyphs are evicted when glyph texture is full. Suited for large character sets, such as CJK
+     */
+    constructor(options: {
+        path: string;
+        name?: string;
+        fontSize?: number;
+        codepoints?: number[] | Int32Array;
+        dynamic?: boolean;
+    });
+
+    /**
+     * Rasterize font on worker thread and upload it at start of next frame. Accepts same arguments as constructor
+     * @returns Promise resolved with loaded font
+     */
+    static load(path: string): Promise<Font>;
+
+    static load(options: { name: string }): Promise<Font>;
+
+    static load(options: {
+        path: string;
+        name?: string;
+        fontSize?: number;
+        codepoints?: number[] | Int32Array;
+        dynamic?: boolean;
+    }): Promise<Font>;
 
     get valid(): boolean;
 }
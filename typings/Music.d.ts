@@ -7,6 +7,13 @@ export class Music {
      */
     constructor(path: string);
 
+    /**
+     * Open music on worker thread without blocking game loop
+     * @param path Path to music file
+     * @returns Promise resolved with loaded music
+     */
+    static load(path: string): Promise<Music>;
+
     /**
      * Is music playing
      */
@@ -15,6 +15,13 @@ export class Sound {
      */
     constructor(path: string);
 
+    /**
+     * Decode sound on worker thread without blocking game loop
+     * @param path Path to sound file
+     * @returns Promise resolved with loaded sound
+     */
+    static load(path: string): Promise<Sound>;
+
     /**
      * Is sound playing
      */
@@ -0,0 +1,47 @@
+import Texture from "glint:Texture";
+
+/**
+ * Draws many sprites from one texture with a single native call
+ *
+ * Sprites are described by packed records in a `Float32Array`. Each record is
+ * {@link SpriteBatch.STRIDE} floats long:
+ *
+ * | Index | Field                                  |
+ * | ----- | -------------------------------------- |
+ * | 0, 1  | Position of sprite center (x, y)       |
+ * | 2..5  | Source rectangle (x, y, width, height) |
+ * | 6     | Rotation in degrees                    |
+ * | 7, 8  | Scale (x, y)                           |
+ * | 9..12 | Tint (r, g, b, a), from 0 to 255       |
+ *
+ * @example
+ * ```js
+ * import SpriteBatch from "glint:SpriteBatch";
+ * import Texture from "glint:Texture";
+ *
+ * const texture = new Texture("sprite.png");
+ * const batch = new SpriteBatch(texture);
+ * const records = new Float32Array(1000 * SpriteBatch.STRIDE);
+ *
+ * // Fill records and then draw all of them at once
+ * batch.draw(records);
+ * ```
+ */
+export class SpriteBatch {
+    /** Number of floats in one sprite record */
+    static readonly STRIDE: number;
+
+    /**
+     * @param texture Texture used by every sprite in the batch
+     */
+    constructor(texture: Texture);
+
+    /**
+     * Draw sprites described by records
+     * @param records Packed sprite records
+     * @param count Number of sprites to draw. Defaults to every complete record
+     */
+    draw(records: Float32Array, count?: number): SpriteBatch;
+}
+
+export default SpriteBatch;
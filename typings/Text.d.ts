@@ -22,7 +22,8 @@ export interface CodepointText extends BaseText {
 }
 
 export interface CodepointsText extends BaseText {
-    codepoints: number[];
+    /** Int32Array is copied at once, without reading elements one by one */
+    codepoints: number[] | Int32Array;
 }
 
 export type Text = StringText | CodepointText | CodepointsText;
@@ -0,0 +1,51 @@
+import { BasicColor } from "glint:Color";
+import { Font } from "glint:Font";
+import { BasicVector2 } from "glint:Vector2";
+
+export interface TextLayoutOptions {
+    text: string;
+    fontSize: number;
+    spacing?: number;
+    /** Defaults to raylib default font */
+    font?: Font;
+}
+
+/**
+ * Text shaped once into glyph quads, that can be drawn many times
+ *
+ * Layout is redone only when `text`, `fontSize` or `spacing` change, so static labels cost one native call per
+ * frame instead of converting and measuring the whole text as `graphics.textPro` does.
+ *
+ * @example
+ * ```js
+ * import TextLayout from "glint:TextLayout";
+ *
+ * const score = new TextLayout({ text: "Score: 0", fontSize: 24 });
+ *
+ * // In draw callback
+ * score.draw({ x: 10, y: 10 }, { r: 255, g: 255, b: 255, a: 255 });
+ * ```
+ */
+export class TextLayout {
+    constructor(options: TextLayoutOptions);
+
+    text: string;
+    fontSize: number;
+    spacing: number;
+
+    /** Width of the longest line */
+    get width(): number;
+
+    get height(): number;
+
+    /**
+     * Draw cached glyphs
+     * @param position Position of layout origin on screen
+     * @param color Text color
+     * @param origin Point of layout that is placed at position and rotated around. Defaults to top left corner
+     * @param rotation Rotation in degrees
+     */
+    draw(position: BasicVector2, color: BasicColor, origin?: BasicVector2, rotation?: number): TextLayout;
+}
+
+export default TextLayout;
@@ -30,6 +30,16 @@ export class Texture {
 
     constructor(options: { path: string; name?: string });
 
+    /**
+     * Decode image on worker thread and upload it at start of next frame. Accepts same arguments as constructor
+     * @returns Promise resolved with loaded texture
+     */
+    static load(path: string): Promise<Texture>;
+
+    static load(options: { name: string }): Promise<Texture>;
+
+    static load(options: { path: string; name?: string }): Promise<Texture>;
+
     /**
      * Check if a texture is valid (loaded in GPU)
      */
@@ -104,6 +104,74 @@ export interface Config {
          */
         interlaced?: boolean;
     };
+
+    /**
+     * Simulation loop options. By default `update` is called once per frame
+     * with variable `screen.dt`
+     */
+    loop?: {
+        /**
+         * Enables fixed step loop. `update` is called zero or more times per
+         * frame, each time advancing simulation by exactly `fixedStep` seconds
+         */
+        fixedStep?: number;
+
+        /**
+         * Maximum number of `update` calls per frame. When game falls further
+         * behind, remaining steps are dropped. Defaults to 8
+         */
+        maxSubsteps?: number;
+
+        /**
+         * Seconds per frame spent running promise continuations. Jobs left
+         * when budget runs out continue next frame. Defaults to 0.004
+         */
+        jobBudget?: number;
+    };
+
+    /**
+     * Run game without window and audio device for benchmarking. Engine
+     * calls `update` and `draw` for a fixed number of frames, then prints
+     * frame time statistics. Drawing functions do nothing in this mode.
+     *
+     * Can also be enabled with `--headless`, `--frames N` and `--dt SECONDS`
+     * command line options, which take precedence over this config
+     */
+    headless?: {
+        /**
+         * Set to run game headless
+         */
+        enabled?: boolean;
+
+        /**
+         * Number of frames to run. Defaults to 600
+         */
+        frames?: number;
+
+        /**
+         * Fixed time step of each frame in seconds, reported by `screen.dt`.
+         * Defaults to 1/60
+         */
+        dt?: number;
+    };
+
+    /**
+     * Memory budgets of resource caches. Textures and fonts that are no
+     * longer referenced stay loaded, so that loading them by name again is
+     * free, until their cache goes over budget. Then least recently released
+     * ones are unloaded, and loading them by name reloads them from file
+     */
+    resources?: {
+        /**
+         * Texture memory budget in MiB. Defaults to 256
+         */
+        textureBudget?: number;
+
+        /**
+         * Font memory budget in MiB. Defaults to 32
+         */
+        fontBudget?: number;
+    };
 }
 
 /**
@@ -1,3 +1,4 @@
+import { AtlasRegion } from "glint:Atlas";
 import Camera from "glint:Camera";
 import { BasicColor } from "glint:Color";
 import NPatch from "glint:NPatch";
@@ -19,12 +20,23 @@ export interface Graphics {
     beginCameraMode(camera: Camera): Graphics;
     endCameraMode(): Graphics;
 
-    texture(texture: Texture, x: number, y: number, tint: BasicColor): Graphics;
-    textureV(texture: Texture, position: BasicVector2, tint: BasicColor): Graphics;
-    textureEx(texture: Texture, position: BasicVector2, rotation: number, scale: number, tint: BasicColor): Graphics;
-    textureRec(texture: Texture, source: BasicRectangle, position: BasicVector2, tint: BasicColor): Graphics;
+    texture(texture: Texture | AtlasRegion, x: number, y: number, tint: BasicColor): Graphics;
+    textureV(texture: Texture | AtlasRegion, position: BasicVector2, tint: BasicColor): Graphics;
+    textureEx(
+        texture: Texture | AtlasRegion,
+        position: BasicVector2,
+        rotation: number,
+        scale: number,
+        tint: BasicColor,
+    ): Graphics;
+    textureRec(
+        texture: Texture | AtlasRegion,
+        source: BasicRectangle,
+        position: BasicVector2,
+        tint: BasicColor,
+    ): Graphics;
     texturePro(
-        texture: Texture,
+        texture: Texture | AtlasRegion,
         source: BasicRectangle,
         dest: BasicRectangle,
         origin: BasicVector2,
@@ -32,7 +44,7 @@ export interface Graphics {
         tint: BasicColor,
     ): Graphics;
     textureNPatch(
-        texture: Texture,
+        texture: Texture | AtlasRegion,
         nPatch: NPatch,
         dest: BasicRectangle,
         origin: BasicVector2,
@@ -1,11 +1,18 @@
+export { Atlas, type AtlasOptions, type AtlasRegion } from "glint:Atlas";
 export { Camera } from "glint:Camera";
 export { Color, type BasicColor } from "glint:Color";
 export { console } from "glint:console";
 export { graphics } from "glint:graphics";
 export { Music } from "glint:Music";
 export { NPatch } from "glint:NPatch";
+export { ParticleEmitter, type ParticleEmitterOptions } from "glint:ParticleEmitter";
+export { profiler } from "glint:profiler";
 export { Rectangle, type BasicRectangle } from "glint:Rectangle";
 export { screen } from "glint:screen";
+export { simd } from "glint:simd";
 export { Sound } from "glint:Sound";
+export { SpriteBatch } from "glint:SpriteBatch";
+export { TextLayout, type TextLayoutOptions } from "glint:TextLayout";
 export { Texture } from "glint:Texture";
+export { timers } from "glint:timers";
 export { Vector2, type BasicVector2 } from "glint:Vector2";
@@ -0,0 +1,33 @@
+/**
+ * Named zones shown in trace written with `--profile TRACE_FILE`, next to
+ * zones of engine. When game is not profiled both calls do nothing, so they
+ * can stay in shipped code.
+ *
+ * @inline
+ */
+export interface Profiler {
+    /**
+     * Open zone, closed by matching `end`. Zones nest like calls. Zones
+     * still open when frame ends are closed there
+     *
+     * @example
+     * ```js
+     * profiler.begin("pathfinding");
+     * findPaths();
+     * profiler.end();
+     * ```
+     */
+    begin(name: string): void;
+
+    /**
+     * Close innermost open zone
+     * @throws RangeError when no zone is open
+     */
+    end(): void;
+
+    /** Whether zones are recorded */
+    readonly enabled: boolean;
+}
+
+export declare const profiler: Profiler;
+export default profiler;
@@ -2,12 +2,22 @@
  * @inline
  */
 export interface Screen {
-    /** Time since last frame in seconds */
+    /**
+     * Time since last frame in seconds. With fixed step loop (`config.loop`)
+     * this is always `fixedStep`
+     */
     get dt(): number;
 
     /** Time since window initialization */
     get time(): number;
 
+    /**
+     * How far rendering is between the last and the next fixed step update,
+     * in range [0, 1). Use it in `draw` to interpolate between previous and
+     * current state. Always 1 when fixed step loop is disabled
+     */
+    get alpha(): number;
+
     /** Width of the game screen */
     get width(): number;
 
@@ -0,0 +1,50 @@
+import { BasicVector2 } from "glint:Vector2";
+
+/**
+ * Operations over many vectors at once, stored as `Float32Array` of xy
+ * pairs. Arrays are changed in place and returned, arrays passed together
+ * must hold same number of vectors.
+ *
+ * @example
+ * ```js
+ * const positions = new Float32Array(count * 2);
+ * const velocities = new Float32Array(count * 2);
+ * simd.mulAdd(positions, velocities, dt);
+ * ```
+ *
+ * @inline
+ */
+export interface Simd {
+    /** Add `offsets` pair by pair, or same offset to every vector */
+    add(vectors: Float32Array, offsets: Float32Array | BasicVector2): Float32Array;
+
+    /** Multiply every vector by number, or its components by components of `factor` */
+    scale(vectors: Float32Array, factor: number | BasicVector2): Float32Array;
+
+    /** `vectors += deltas * factor`, like `position += velocity * dt` */
+    mulAdd(vectors: Float32Array, deltas: Float32Array, factor: number): Float32Array;
+
+    /** Rotate every vector by angle in radians */
+    rotate(vectors: Float32Array, angle: number): Float32Array;
+
+    /** Scale every vector to length 1, zero vectors stay zero */
+    normalize(vectors: Float32Array): Float32Array;
+
+    /** Clamp components of every vector between components of `min` and `max` */
+    clamp(vectors: Float32Array, min: BasicVector2, max: BasicVector2): Float32Array;
+
+    /**
+     * Distance from every vector to `point`
+     * @param out Array of one element per vector to write distances into, new one is created when omitted
+     */
+    distance(vectors: Float32Array, point: BasicVector2, out?: Float32Array): Float32Array;
+
+    /** Move every vector towards its target by `amount` of distance between them */
+    lerp(vectors: Float32Array, targets: Float32Array, amount: number): Float32Array;
+
+    /** Vector instructions engine was built with: `AVX`, `SSE2`, `NEON` or `scalar` */
+    readonly instructionSet: string;
+}
+
+export declare const simd: Simd;
+export default simd;
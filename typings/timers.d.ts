@@ -0,0 +1,37 @@
+/**
+ * Timers run at frame boundary, before `update`, and follow `screen.time`,
+ * so in headless mode they advance by fixed `dt` too. A callback never runs
+ * on the frame it was scheduled from.
+ *
+ * @inline
+ */
+export interface Timers {
+    /**
+     * Call `callback` once after at least `ms` milliseconds
+     * @returns Id for `clearTimeout`
+     */
+    setTimeout(callback: () => void, ms?: number): number;
+
+    clearTimeout(id: number): void;
+
+    /**
+     * Call `callback` at start of next frame
+     * @returns Id for `cancelFrame`
+     */
+    requestFrame(callback: (dt: number) => void): number;
+
+    cancelFrame(id: number): void;
+
+    /**
+     * Promise resolved after at least `ms` milliseconds
+     *
+     * @example
+     * ```js
+     * await timers.delay(500);
+     * ```
+     */
+    delay(ms?: number): Promise<void>;
+}
+
+export declare const timers: Timers;
+export default timers;
@@ -2,6 +2,7 @@ add_rules("mode.debug", "mode.release")
 add_rules("plugin.compile_commands.autoupdate", { outputdir = "build" })
 
 add_requires("fmt", { configs = { header_only = false } })
+add_requires("libvorbis 1.3.7")
 add_requires("libzip v1.11.4")
 add_requires("microsoft-gsl v4.2.1")
 add_requires("quickjs-ng v0.11.0", { alias = "quickjs", configs = { debug = true } })
@@ -18,19 +19,35 @@ end
 target("glint", function()
 	set_kind("binary")
 	add_files(
+		"src/asset_loader.cpp",
+		"src/atlas.cpp",
+		"src/atlas_packer.cpp",
+		"src/binding_trace.cpp",
+		"src/bytecode_cache.cpp",
 		"src/engine.cpp",
 		"src/error.cpp",
 		"src/file_store.cpp",
+		"src/glyph_cache.cpp",
 		"src/quickjs.cpp",
+		"src/simd.cpp",
 		"src/main.cpp",
+		"src/pack.cpp",
+		"src/profiler.cpp",
+		"src/texture_container.cpp",
+		"src/timers.cpp",
 		"src/plugins/*.cpp"
 	)
 	add_files("src/**.js")
 	add_includedirs("src", { public = true })
 	add_headerfiles("src/(**.hpp)")
-	add_packages({ "quickjs", "fmt", "libzip", "spdlog", "raylib", "microsoft-gsl" })
+	add_packages({ "quickjs", "fmt", "libvorbis", "libzip", "spdlog", "raylib", "microsoft-gsl" })
 	add_defines("SPDLOG_COMPILED_LIB")
-	add_defines("SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE")
+	-- Trace logs are compiled out of release builds, calls of bindings are traced with `--trace-bindings` instead
+	if is_mode("release") then
+		add_defines("SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_DEBUG")
+	else
+		add_defines("SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE")
+	end
 	add_rules("utils.bin2c", { extensions = ".js" })
 end)
 